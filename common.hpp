@@ -50,6 +50,7 @@
 #endif
 
 #include <cstddef>
+#include <deque>
 #include <list>
 #include <map>
 #include <set>
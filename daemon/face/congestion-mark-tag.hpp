@@ -0,0 +1,80 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2014-2015,  Regents of the University of California,
+ *                           Arizona Board of Regents,
+ *                           Colorado State University,
+ *                           University Pierre & Marie Curie, Sorbonne University,
+ *                           Washington University in St. Louis,
+ *                           Beijing Institute of Technology,
+ *                           The University of Memphis.
+ *
+ * This file is part of NFD (Named Data Networking Forwarding Daemon).
+ * See AUTHORS.md for complete list of NFD authors and contributors.
+ *
+ * NFD is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * NFD is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * NFD, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+#ifndef NFD_DAEMON_FACE_CONGESTION_MARK_TAG_HPP
+#define NFD_DAEMON_FACE_CONGESTION_MARK_TAG_HPP
+
+#include "common.hpp"
+
+#include <ndn-cxx/tag.hpp>
+
+namespace nfd {
+
+/** \brief indicates that a Data has passed through a congested output queue
+ *
+ *  fw::TrafficManager attaches this tag to Data that waited longer than the target
+ *  queueing delay. Faces that use NDNLP carry the mark in the NdnlpCongestionMark field,
+ *  and attach the tag again to the Data they receive, so that the mark reaches strategies
+ *  on the next hop (via fw::LinkEstimation) and eventually the consumer.
+ */
+class CongestionMarkTag : public ndn::Tag
+{
+public:
+  static size_t
+  getTypeId()
+  {
+    // next to ns3::ndn::Ns3PacketTag (0x60000000)
+    return 0x60000001;
+  }
+
+  explicit
+  CongestionMarkTag(uint64_t mark = 1)
+    : m_mark(mark)
+  {
+  }
+
+  uint64_t
+  get() const
+  {
+    return m_mark;
+  }
+
+private:
+  uint64_t m_mark;
+};
+
+/** \return congestion mark of data, or 0 if data is not marked
+ */
+inline uint64_t
+getCongestionMark(const Data& data)
+{
+  shared_ptr<CongestionMarkTag> tag = data.getTag<CongestionMarkTag>();
+  return tag == nullptr ? 0 : tag->get();
+}
+
+} // namespace nfd
+
+#endif // NFD_DAEMON_FACE_CONGESTION_MARK_TAG_HPP
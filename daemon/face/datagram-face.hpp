@@ -27,6 +27,7 @@
 #define NFD_DAEMON_FACE_DATAGRAM_FACE_HPP
 
 #include "face.hpp"
+#include "input-buffer-pool.hpp"
 #include "core/global-io.hpp"
 
 namespace nfd {
@@ -71,9 +72,15 @@ protected:
              size_t nBytesSent,
              const Block& payload);
 
+  /** \brief read one datagram once the socket is readable
+   *
+   *  A buffer is leased from the input buffer pool only for the duration of the read.
+   */
   void
-  handleReceive(const boost::system::error_code& error,
-                size_t nBytesReceived);
+  handleReceive(const boost::system::error_code& error);
+
+  void
+  asyncWaitReadable();
 
   void
   keepFaceAliveUntilAllHandlersExecuted(const shared_ptr<Face>& face);
@@ -96,7 +103,6 @@ protected:
   NFD_LOG_INCLASS_DECLARE();
 
 private:
-  uint8_t m_inputBuffer[ndn::MAX_NDN_PACKET_SIZE];
   bool m_hasBeenUsedRecently;
 };
 
@@ -110,10 +116,9 @@ DatagramFace<T, U>::DatagramFace(const FaceUri& remoteUri, const FaceUri& localU
 {
   NFD_LOG_FACE_INFO("Creating face");
 
-  m_socket.async_receive(boost::asio::buffer(m_inputBuffer, ndn::MAX_NDN_PACKET_SIZE),
-                         bind(&DatagramFace<T, U>::handleReceive, this,
-                              boost::asio::placeholders::error,
-                              boost::asio::placeholders::bytes_transferred));
+  // reads are issued only after the socket is reported readable, and must not block
+  m_socket.non_blocking(true);
+  asyncWaitReadable();
 }
 
 template<class T, class U>
@@ -205,16 +210,34 @@ DatagramFace<T, U>::handleSend(const boost::system::error_code& error,
 
 template<class T, class U>
 inline void
-DatagramFace<T, U>::handleReceive(const boost::system::error_code& error,
-                                  size_t nBytesReceived)
+DatagramFace<T, U>::asyncWaitReadable()
 {
-  receiveDatagram(m_inputBuffer, nBytesReceived, error);
+  m_socket.async_receive(boost::asio::null_buffers(),
+                         bind(&DatagramFace<T, U>::handleReceive, this,
+                              boost::asio::placeholders::error));
+}
+
+template<class T, class U>
+inline void
+DatagramFace<T, U>::handleReceive(const boost::system::error_code& error)
+{
+  if (error)
+    {
+      receiveDatagram(nullptr, 0, error);
+    }
+  else
+    {
+      InputBufferPool::Lease buffer(getGlobalInputBufferPool());
+      boost::system::error_code readError;
+      size_t nBytesReceived = m_socket.receive(boost::asio::buffer(buffer.get(),
+                                                                   InputBufferPool::BUFFER_SIZE),
+                                               0, readError);
+      if (readError != boost::asio::error::would_block)
+        receiveDatagram(buffer.get(), nBytesReceived, readError);
+    }
 
   if (m_socket.is_open())
-    m_socket.async_receive(boost::asio::buffer(m_inputBuffer, ndn::MAX_NDN_PACKET_SIZE),
-                           bind(&DatagramFace<T, U>::handleReceive, this,
-                                boost::asio::placeholders::error,
-                                boost::asio::placeholders::bytes_transferred));
+    asyncWaitReadable();
 }
 
 template<class T, class U>
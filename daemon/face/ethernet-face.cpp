@@ -24,7 +24,9 @@
  */
 
 #include "ethernet-face.hpp"
+#include "congestion-mark-tag.hpp"
 #include "core/global-io.hpp"
+#include "core/scheduler.hpp"
 
 #include <pcap/pcap.h>
 
@@ -35,6 +37,7 @@
 #include <net/ethernet.h> // for struct ether_header
 #include <net/if.h>       // for struct ifreq
 #include <sys/ioctl.h>    // for ioctl()
+#include <sys/uio.h>      // for writev()
 #include <unistd.h>       // for dup()
 
 #if defined(__linux__)
@@ -42,6 +45,10 @@
 #include <sys/socket.h>       // for setsockopt()
 #endif
 
+#ifdef HAVE_TPACKET_V3
+#include <linux/filter.h>     // for struct sock_fprog
+#endif
+
 #ifdef SIOCADDMULTI
 #if defined(__APPLE__) || defined(__FreeBSD__)
 #include <net/if_dl.h>    // for struct sockaddr_dl
@@ -60,13 +67,15 @@ namespace nfd {
 
 NFD_LOG_INIT("EthernetFace");
 
-const time::nanoseconds EthernetFace::REASSEMBLER_LIFETIME = time::seconds(60);
-
 EthernetFace::EthernetFace(boost::asio::posix::stream_descriptor socket,
                            const NetworkInterfaceInfo& interface,
-                           const ethernet::Address& address)
+                           const ethernet::Address& address,
+                           bool usePacketRing)
   : Face(FaceUri(address), FaceUri::fromDev(interface.name), false, true)
   , m_pcap(nullptr, pcap_close)
+#ifdef HAVE_TPACKET_V3
+  , m_isFlushScheduled(false)
+#endif
   , m_socket(std::move(socket))
 #if defined(__linux__)
   , m_interfaceIndex(interface.index)
@@ -79,21 +88,6 @@ EthernetFace::EthernetFace(boost::asio::posix::stream_descriptor socket,
 #endif
 {
   NFD_LOG_FACE_INFO("Creating face on " << m_interfaceName << "/" << m_srcAddress);
-  pcapInit();
-
-  int fd = pcap_get_selectable_fd(m_pcap.get());
-  if (fd < 0)
-    BOOST_THROW_EXCEPTION(Error("pcap_get_selectable_fd failed"));
-
-  // need to duplicate the fd, otherwise both pcap_close()
-  // and stream_descriptor::close() will try to close the
-  // same fd and one of them will fail
-  m_socket.assign(::dup(fd));
-
-  m_interfaceMtu = getInterfaceMtu();
-  NFD_LOG_FACE_DEBUG("Interface MTU is: " << m_interfaceMtu);
-
-  m_slicer.reset(new ndnlp::Slicer(m_interfaceMtu));
 
   char filter[100];
   // std::snprintf not found in some environments
@@ -103,12 +97,73 @@ EthernetFace::EthernetFace(boost::asio::posix::stream_descriptor socket,
            ethernet::ETHERTYPE_NDN,
            m_destAddress.toString().c_str(),
            m_srcAddress.toString().c_str());
-  setPacketFilter(filter);
+
+#ifdef HAVE_TPACKET_V3
+  if (usePacketRing)
+    {
+      try
+        {
+          ringInit(filter);
+        }
+      catch (const EthernetPacketRing::Error& e)
+        {
+          NFD_LOG_FACE_WARN("Cannot set up packet ring (" << e.what()
+                            << "), falling back to libpcap");
+          boost::system::error_code error;
+          m_socket.close(error); // ignore errors
+          m_ring.reset();
+        }
+    }
+
+  if (!m_ring)
+#endif
+    {
+      pcapInit();
+
+      int fd = pcap_get_selectable_fd(m_pcap.get());
+      if (fd < 0)
+        BOOST_THROW_EXCEPTION(Error("pcap_get_selectable_fd failed"));
+
+      // need to duplicate the fd, otherwise both pcap_close()
+      // and stream_descriptor::close() will try to close the
+      // same fd and one of them will fail
+      m_socket.assign(::dup(fd));
+
+      m_interfaceMtu = getInterfaceMtu();
+      setPacketFilter(filter);
+    }
+
+  NFD_LOG_FACE_DEBUG("Interface MTU is: " << m_interfaceMtu);
+
+  m_slicer.reset(new ndnlp::Slicer(m_interfaceMtu));
+
+  m_reassembler.onReceive.connect([this] (const Block& block, uint64_t congestionMark) {
+    NFD_LOG_FACE_TRACE("All fragments received");
+    if (!decodeAndDispatchInput(block, congestionMark))
+      NFD_LOG_FACE_WARN("Received unrecognized TLV block of type " << block.type());
+  });
+
+  static uint16_t ethertype = htons(ethernet::ETHERTYPE_NDN);
+  uint8_t* end = std::copy(m_destAddress.begin(), m_destAddress.end(), m_frameHeader);
+  end = std::copy(m_srcAddress.begin(), m_srcAddress.end(), end);
+  std::copy_n(reinterpret_cast<const uint8_t*>(&ethertype), ethernet::TYPE_LEN, end);
 
   if (!m_destAddress.isBroadcast() && !joinMulticastGroup())
     {
       NFD_LOG_FACE_WARN("Falling back to promiscuous mode");
-      pcap_set_promisc(m_pcap.get(), 1);
+#ifdef HAVE_TPACKET_V3
+      if (m_ring)
+        {
+          packet_mreq mr{};
+          mr.mr_ifindex = m_interfaceIndex;
+          mr.mr_type = PACKET_MR_PROMISC;
+          if (::setsockopt(m_socket.native_handle(), SOL_PACKET,
+                           PACKET_ADD_MEMBERSHIP, &mr, sizeof(mr)) < 0)
+            NFD_LOG_FACE_WARN("setsockopt(PACKET_MR_PROMISC) failed: " << std::strerror(errno));
+        }
+      else
+#endif
+        pcap_set_promisc(m_pcap.get(), 1);
     }
 
   m_socket.async_read_some(boost::asio::null_buffers(),
@@ -124,9 +179,9 @@ EthernetFace::sendInterest(const Interest& interest)
 
   this->emitSignal(onSendInterest, interest);
 
-  ndnlp::PacketArray pa = m_slicer->slice(interest.wireEncode());
-  for (const auto& packet : *pa) {
-    sendPacket(packet);
+  m_slicer->slice(interest.wireEncode(), m_fragments);
+  for (const auto& fragment : m_fragments) {
+    sendPacket(fragment);
   }
 }
 
@@ -137,16 +192,16 @@ EthernetFace::sendData(const Data& data)
 
   this->emitSignal(onSendData, data);
 
-  ndnlp::PacketArray pa = m_slicer->slice(data.wireEncode());
-  for (const auto& packet : *pa) {
-    sendPacket(packet);
+  m_slicer->slice(data.wireEncode(), m_fragments, getCongestionMark(data));
+  for (const auto& fragment : m_fragments) {
+    sendPacket(fragment);
   }
 }
 
 void
 EthernetFace::close()
 {
-  if (!m_pcap)
+  if (isClosed())
     return;
 
   NFD_LOG_FACE_INFO("Closing face");
@@ -155,10 +210,18 @@ EthernetFace::close()
   m_socket.cancel(error); // ignore errors
   m_socket.close(error);  // ignore errors
   m_pcap.reset();
+  // the packet ring is unmapped by the destructor, as close() may be called
+  // while a frame in the receive ring is being processed
 
   fail("Face closed");
 }
 
+bool
+EthernetFace::isClosed() const
+{
+  return !m_socket.is_open();
+}
+
 void
 EthernetFace::pcapInit()
 {
@@ -186,6 +249,44 @@ EthernetFace::pcapInit()
     NFD_LOG_FACE_WARN("pcap_setdirection failed: " << pcap_geterr(m_pcap.get()));
 }
 
+#ifdef HAVE_TPACKET_V3
+void
+EthernetFace::ringInit(const char* filterString)
+{
+  // ring slots are sized from the MTU, so it is queried before the socket exists
+  m_interfaceMtu = getInterfaceMtu();
+
+  m_ring.reset(new EthernetPacketRing(ethernet::HDR_LEN + m_interfaceMtu));
+  // the ring owns its fd, see pcap case in the constructor
+  m_socket.assign(::dup(m_ring->getFd()));
+
+  // libpcap is still used to compile the filter, which is then attached directly
+  unique_ptr<pcap_t, void(*)(pcap_t*)> compiler(pcap_open_dead(DLT_EN10MB,
+                                                               m_ring->getMaxFrameLength()),
+                                                pcap_close);
+  if (!compiler)
+    BOOST_THROW_EXCEPTION(EthernetPacketRing::Error("pcap_open_dead failed"));
+
+  bpf_program filter;
+  if (pcap_compile(compiler.get(), &filter, filterString, 1, PCAP_NETMASK_UNKNOWN) < 0)
+    BOOST_THROW_EXCEPTION(EthernetPacketRing::Error("pcap_compile: " +
+                                                    std::string(pcap_geterr(compiler.get()))));
+
+  // struct bpf_insn and struct sock_filter have the same layout
+  sock_fprog program{};
+  program.len = filter.bf_len;
+  program.filter = reinterpret_cast<sock_filter*>(filter.bf_insns);
+  int ret = ::setsockopt(m_ring->getFd(), SOL_SOCKET, SO_ATTACH_FILTER, &program, sizeof(program));
+  pcap_freecode(&filter);
+  if (ret < 0)
+    BOOST_THROW_EXCEPTION(EthernetPacketRing::Error("setsockopt(SO_ATTACH_FILTER): " +
+                                                    std::string(std::strerror(errno))));
+
+  // start receiving only after the filter is in place
+  m_ring->bind(m_interfaceIndex, ethernet::ETHERTYPE_NDN);
+}
+#endif
+
 void
 EthernetFace::setPacketFilter(const char* filterString)
 {
@@ -266,63 +367,146 @@ EthernetFace::joinMulticastGroup()
 }
 
 void
-EthernetFace::sendPacket(const ndn::Block& block)
+EthernetFace::sendPacket(const ndnlp::Fragment& fragment)
 {
-  if (!m_pcap)
+  if (isClosed())
     {
       NFD_LOG_FACE_WARN("Trying to send on closed face");
       return fail("Face closed");
     }
 
-  BOOST_ASSERT(block.size() <= m_interfaceMtu);
+  BOOST_ASSERT(fragment.size() <= m_interfaceMtu);
 
-  /// \todo Right now there is no reserve when packet is received, but
-  ///       we should reserve some space at the beginning and at the end
-  ndn::EncodingBuffer buffer(block);
+#ifdef HAVE_TPACKET_V3
+  if (m_ring)
+    return sendPacketOnRing(fragment);
+#endif
+
+  iovec iov[4];
+  iov[0].iov_base = m_frameHeader;
+  iov[0].iov_len = ethernet::HDR_LEN;
+  iov[1].iov_base = const_cast<uint8_t*>(fragment.getHeader());
+  iov[1].iov_len = fragment.getHeaderSize();
+  iov[2].iov_base = const_cast<uint8_t*>(fragment.getPayload());
+  iov[2].iov_len = fragment.getPayloadSize();
+  int iovCount = 3;
 
   // pad with zeroes if the payload is too short
-  if (block.size() < ethernet::MIN_DATA_LEN)
+  if (fragment.size() < ethernet::MIN_DATA_LEN)
     {
       static const uint8_t padding[ethernet::MIN_DATA_LEN] = {};
-      buffer.appendByteArray(padding, ethernet::MIN_DATA_LEN - block.size());
+      iov[3].iov_base = const_cast<uint8_t*>(padding);
+      iov[3].iov_len = ethernet::MIN_DATA_LEN - fragment.size();
+      ++iovCount;
     }
 
-  // construct and prepend the ethernet header
-  static uint16_t ethertype = htons(ethernet::ETHERTYPE_NDN);
-  buffer.prependByteArray(reinterpret_cast<const uint8_t*>(&ethertype), ethernet::TYPE_LEN);
-  buffer.prependByteArray(m_srcAddress.data(), m_srcAddress.size());
-  buffer.prependByteArray(m_destAddress.data(), m_destAddress.size());
-
-  // send the packet
-  int sent = pcap_inject(m_pcap.get(), buffer.buf(), buffer.size());
+  // libpcap's socket (Linux) or BPF device (BSD) accepts one frame per write,
+  // and pcap_inject is a plain write, so the frame can be gathered instead
+  size_t frameSize = ethernet::HDR_LEN + std::max(fragment.size(), ethernet::MIN_DATA_LEN);
+  ssize_t sent = ::writev(m_socket.native_handle(), iov, iovCount);
   if (sent < 0)
     {
-      return fail("pcap_inject: " + std::string(pcap_geterr(m_pcap.get())));
+      return fail("writev: " + std::string(std::strerror(errno)));
     }
-  else if (static_cast<size_t>(sent) < buffer.size())
+  else if (static_cast<size_t>(sent) < frameSize)
     {
       return fail("Failed to inject frame");
     }
 
-  NFD_LOG_FACE_TRACE("Successfully sent: " << block.size() << " bytes");
-  this->getMutableCounters().getNOutBytes() += block.size();
+  NFD_LOG_FACE_TRACE("Successfully sent: " << fragment.size() << " bytes");
+  this->getMutableCounters().getNOutBytes() += fragment.size();
+}
+
+#ifdef HAVE_TPACKET_V3
+void
+EthernetFace::sendPacketOnRing(const ndnlp::Fragment& fragment)
+{
+  uint8_t* frame = m_ring->allocateFrame();
+  if (frame == nullptr)
+    {
+      // every slot holds a frame that has not been sent yet
+      if (!m_ring->flush())
+        return fail("Failed to send frames: " + std::string(std::strerror(errno)));
+
+      frame = m_ring->allocateFrame();
+      if (frame == nullptr)
+        {
+          NFD_LOG_FACE_WARN("Transmit ring is full, dropping frame");
+          return;
+        }
+    }
+
+  // the frame is built in place in the ring
+  uint8_t* end = std::copy_n(m_frameHeader, ethernet::HDR_LEN, frame);
+  end = std::copy_n(fragment.getHeader(), fragment.getHeaderSize(), end);
+  end = std::copy_n(fragment.getPayload(), fragment.getPayloadSize(), end);
+
+  // pad with zeroes if the payload is too short
+  if (fragment.size() < ethernet::MIN_DATA_LEN)
+    end = std::fill_n(end, ethernet::MIN_DATA_LEN - fragment.size(), 0);
+
+  m_ring->commitFrame(end - frame);
+
+  NFD_LOG_FACE_TRACE("Queued: " << fragment.size() << " bytes");
+  this->getMutableCounters().getNOutBytes() += fragment.size();
+
+  if (!m_isFlushScheduled)
+    {
+      m_isFlushScheduled = true;
+      scheduler::schedule(time::nanoseconds::zero(),
+                          bind(&EthernetFace::flushFrames, this, shared_from_this()));
+    }
+}
+
+void
+EthernetFace::flushFrames(const shared_ptr<Face>& face)
+{
+  m_isFlushScheduled = false;
+  if (isClosed())
+    return;
+
+  if (!m_ring->flush())
+    fail("Failed to send frames: " + std::string(std::strerror(errno)));
 }
+#endif
 
 void
 EthernetFace::handleRead(const boost::system::error_code& error, size_t)
 {
-  if (!m_pcap)
+  if (isClosed())
     return fail("Face closed");
 
   if (error)
     return processErrorCode(error);
 
+#ifdef HAVE_TPACKET_V3
+  if (m_ring)
+    {
+      m_ring->receive(bind(&EthernetFace::processIncomingFrame, this, _1, _2));
+      if (isClosed())
+        return;
+    }
+  else
+#endif
+  if (!readFromPcap())
+    return;
+
+  m_socket.async_read_some(boost::asio::null_buffers(),
+                           bind(&EthernetFace::handleRead, this,
+                                boost::asio::placeholders::error,
+                                boost::asio::placeholders::bytes_transferred));
+}
+
+bool
+EthernetFace::readFromPcap()
+{
   pcap_pkthdr* header;
   const uint8_t* packet;
   int ret = pcap_next_ex(m_pcap.get(), &header, &packet);
   if (ret < 0)
     {
-      return fail("pcap_next_ex: " + std::string(pcap_geterr(m_pcap.get())));
+      fail("pcap_next_ex: " + std::string(pcap_geterr(m_pcap.get())));
+      return false;
     }
   else if (ret == 0)
     {
@@ -331,6 +515,8 @@ EthernetFace::handleRead(const boost::system::error_code& error, size_t)
   else
     {
       processIncomingPacket(header, packet);
+      if (!m_pcap)
+        return false;
     }
 
 #ifdef _DEBUG
@@ -348,16 +534,18 @@ EthernetFace::handleRead(const boost::system::error_code& error, size_t)
     }
 #endif
 
-  m_socket.async_read_some(boost::asio::null_buffers(),
-                           bind(&EthernetFace::handleRead, this,
-                                boost::asio::placeholders::error,
-                                boost::asio::placeholders::bytes_transferred));
+  return true;
 }
 
 void
 EthernetFace::processIncomingPacket(const pcap_pkthdr* header, const uint8_t* packet)
 {
-  size_t length = header->caplen;
+  processIncomingFrame(packet, header->caplen);
+}
+
+void
+EthernetFace::processIncomingFrame(const uint8_t* packet, size_t length)
+{
   if (length < ethernet::HDR_LEN + ethernet::MIN_DATA_LEN) {
     NFD_LOG_FACE_WARN("Received frame is too short (" << length << " bytes)");
     return;
@@ -391,25 +579,6 @@ EthernetFace::processIncomingPacket(const pcap_pkthdr* header, const uint8_t* pa
                      << sourceAddress.toString());
   this->getMutableCounters().getNInBytes() += fragmentBlock.size();
 
-  Reassembler& reassembler = m_reassemblers[sourceAddress];
-  if (!reassembler.pms) {
-    // new sender, setup a PartialMessageStore for it
-    reassembler.pms.reset(new ndnlp::PartialMessageStore);
-    reassembler.pms->onReceive.connect(
-      [this, sourceAddress] (const Block& block) {
-        NFD_LOG_FACE_TRACE("All fragments received from " << sourceAddress.toString());
-        if (!decodeAndDispatchInput(block))
-          NFD_LOG_FACE_WARN("Received unrecognized TLV block of type " << block.type()
-                            << " from " << sourceAddress.toString());
-      });
-  }
-
-  scheduler::cancel(reassembler.expireEvent);
-  reassembler.expireEvent = scheduler::schedule(REASSEMBLER_LIFETIME,
-    [this, sourceAddress] {
-      BOOST_VERIFY(m_reassemblers.erase(sourceAddress) == 1);
-    });
-
   ndnlp::NdnlpData fragment;
   std::tie(isOk, fragment) = ndnlp::NdnlpData::fromBlock(fragmentBlock);
   if (!isOk) {
@@ -417,7 +586,11 @@ EthernetFace::processIncomingPacket(const pcap_pkthdr* header, const uint8_t* pa
     return;
   }
 
-  reassembler.pms->receive(fragment);
+  // the 48-bit source address identifies the sender within the shared store
+  uint64_t senderId = 0;
+  for (uint8_t octet : sourceAddress)
+    senderId = (senderId << 8) | octet;
+  m_reassembler.receive(fragment, senderId);
 }
 
 void
@@ -450,7 +623,15 @@ EthernetFace::getInterfaceMtu()
   udp::socket sock(ref(getGlobalIoService()), udp::v4());
   int fd = sock.native_handle();
 #else
+  // the packet ring needs the MTU before the socket is open
+  using boost::asio::ip::udp;
+  unique_ptr<udp::socket> sock;
   int fd = m_socket.native_handle();
+  if (!m_socket.is_open())
+    {
+      sock.reset(new udp::socket(ref(getGlobalIoService()), udp::v4()));
+      fd = sock->native_handle();
+    }
 #endif
 
   ifreq ifr{};
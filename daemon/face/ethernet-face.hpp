@@ -32,12 +32,14 @@
 #include "ndnlp-slicer.hpp"
 #include "core/network-interface.hpp"
 
-#include <unordered_map>
-
 #ifndef HAVE_LIBPCAP
 #error "Cannot include this file when libpcap is not available"
 #endif
 
+#ifdef HAVE_TPACKET_V3
+#include "ethernet-packet-ring.hpp"
+#endif
+
 // forward declarations
 struct pcap;
 typedef pcap pcap_t;
@@ -60,9 +62,21 @@ public:
     Error(const std::string& what) : Face::Error(what) {}
   };
 
+  /**
+   * @param usePacketRing if true and supported, send and receive through TPACKET_V3
+   *                      memory-mapped rings instead of libpcap; libpcap is used if
+   *                      the rings cannot be set up
+   */
   EthernetFace(boost::asio::posix::stream_descriptor socket,
                const NetworkInterfaceInfo& interface,
-               const ethernet::Address& address);
+               const ethernet::Address& address,
+               bool usePacketRing = false);
+
+  /**
+   * @brief Returns true if frames go through TPACKET_V3 rings rather than libpcap
+   */
+  bool
+  isUsingPacketRing() const;
 
   /// send an Interest
   void
@@ -87,6 +101,32 @@ private:
   void
   pcapInit();
 
+#ifdef HAVE_TPACKET_V3
+  /**
+   * @brief Sets up TPACKET_V3 rings on a new AF_PACKET socket
+   */
+  void
+  ringInit(const char* filterString);
+
+  /**
+   * @brief Writes an Ethernet frame carrying the NDNLP fragment into the transmit ring
+   */
+  void
+  sendPacketOnRing(const ndnlp::Fragment& fragment);
+
+  /**
+   * @brief Sends the frames written to the transmit ring since the last flush
+   *
+   * This is scheduled to run immediately after the first frame is written, so that
+   * the frames written while handling one event are sent with one system call.
+   */
+  void
+  flushFrames(const shared_ptr<Face>& face);
+#endif
+
+  bool
+  isClosed() const;
+
   /**
    * @brief Installs a BPF filter on the receiving socket
    *
@@ -104,10 +144,13 @@ private:
   joinMulticastGroup();
 
   /**
-   * @brief Sends the specified TLV block on the network wrapped in an Ethernet frame
+   * @brief Sends the specified NDNLP fragment on the network wrapped in an Ethernet frame
+   *
+   * The Ethernet header, the NDNLP header, and the payload are gathered by the
+   * kernel, so the network layer packet is not copied.
    */
   void
-  sendPacket(const ndn::Block& block);
+  sendPacket(const ndnlp::Fragment& fragment);
 
   /**
    * @brief Receive callback
@@ -115,6 +158,14 @@ private:
   void
   handleRead(const boost::system::error_code& error, size_t nBytesRead);
 
+  /**
+   * @brief Reads one frame with libpcap
+   *
+   * @return false if the face has failed
+   */
+  bool
+  readFromPcap();
+
 PUBLIC_WITH_TESTS_ELSE_PRIVATE:
   /**
    * @brief Processes an incoming frame as captured by libpcap
@@ -125,6 +176,15 @@ PUBLIC_WITH_TESTS_ELSE_PRIVATE:
   void
   processIncomingPacket(const pcap_pkthdr* header, const uint8_t* packet);
 
+  /**
+   * @brief Processes an incoming frame
+   *
+   * @param packet pointer to the received frame, including the link-layer header
+   * @param length number of captured bytes
+   */
+  void
+  processIncomingFrame(const uint8_t* packet, size_t length);
+
 private:
   /**
    * @brief Handles errors encountered by Boost.Asio on the receive path
@@ -139,13 +199,11 @@ private:
   getInterfaceMtu();
 
 private:
-  struct Reassembler
-  {
-    unique_ptr<ndnlp::PartialMessageStore> pms;
-    scheduler::EventId expireEvent;
-  };
-
   unique_ptr<pcap_t, void(*)(pcap_t*)> m_pcap;
+#ifdef HAVE_TPACKET_V3
+  unique_ptr<EthernetPacketRing> m_ring;
+  bool m_isFlushScheduled;
+#endif
   boost::asio::posix::stream_descriptor m_socket;
 
 #if defined(__linux__)
@@ -157,8 +215,12 @@ private:
 
   size_t m_interfaceMtu;
   unique_ptr<ndnlp::Slicer> m_slicer;
-  std::unordered_map<ethernet::Address, Reassembler> m_reassemblers;
-  static const time::nanoseconds REASSEMBLER_LIFETIME;
+  /// fragments of the packet being sent, kept to reuse their storage
+  ndnlp::FragmentArray m_fragments;
+  /// Ethernet header of outgoing frames
+  uint8_t m_frameHeader[ethernet::HDR_LEN];
+  /// reassembles messages of all senders, within one memory limit
+  ndnlp::PartialMessageStore m_reassembler;
 
 #ifdef _DEBUG
   /// number of packets dropped by the kernel, as reported by libpcap
@@ -166,6 +228,16 @@ private:
 #endif
 };
 
+inline bool
+EthernetFace::isUsingPacketRing() const
+{
+#ifdef HAVE_TPACKET_V3
+  return m_ring != nullptr;
+#else
+  return false;
+#endif
+}
+
 } // namespace nfd
 
 #endif // NFD_DAEMON_FACE_ETHERNET_FACE_HPP
@@ -31,6 +31,15 @@
 
 namespace nfd {
 
+EthernetFactory::EthernetFactory()
+#ifdef HAVE_TPACKET_V3
+  : m_usePacketRing(true)
+#else
+  : m_usePacketRing(false)
+#endif
+{
+}
+
 shared_ptr<EthernetFace>
 EthernetFactory::createMulticastFace(const NetworkInterfaceInfo& interface,
                                      const ethernet::Address &address)
@@ -43,7 +52,7 @@ EthernetFactory::createMulticastFace(const NetworkInterfaceInfo& interface,
     return face;
 
   face = make_shared<EthernetFace>(boost::asio::posix::stream_descriptor(getGlobalIoService()),
-                                   interface, address);
+                                   interface, address, m_usePacketRing);
 
   auto key = std::make_pair(interface.name, address);
   face->onFail.connectSingleShot([this, key] (const std::string& reason) {
@@ -36,6 +36,8 @@ class EthernetFace;
 class EthernetFactory : public ProtocolFactory
 {
 public:
+  EthernetFactory();
+
   /**
    * \brief Exception of EthernetFactory
    */
@@ -87,6 +89,19 @@ public:
   virtual std::list<shared_ptr<const Channel>>
   getChannels() const;
 
+  /**
+   * \brief Set whether faces created afterwards use TPACKET_V3 memory-mapped rings
+   *        instead of libpcap
+   *
+   * Rings are enabled by default if NFD is built with packet ring support
+   * (see --without-packet-ring), and this has no effect otherwise.
+   */
+  void
+  setPacketRingEnabled(bool isEnabled);
+
+  bool
+  isPacketRingEnabled() const;
+
 private:
   /**
    * \brief Look up EthernetFace using specified interface and address
@@ -102,6 +117,7 @@ private:
 
 private:
   MulticastFaceMap m_multicastFaces;
+  bool m_usePacketRing;
 };
 
 inline const EthernetFactory::MulticastFaceMap&
@@ -110,6 +126,18 @@ EthernetFactory::getMulticastFaces() const
   return m_multicastFaces;
 }
 
+inline void
+EthernetFactory::setPacketRingEnabled(bool isEnabled)
+{
+  m_usePacketRing = isEnabled;
+}
+
+inline bool
+EthernetFactory::isPacketRingEnabled() const
+{
+  return m_usePacketRing;
+}
+
 } // namespace nfd
 
 #endif // NFD_DAEMON_FACE_ETHERNET_FACTORY_HPP
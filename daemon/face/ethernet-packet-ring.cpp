@@ -0,0 +1,227 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2014-2015,  Regents of the University of California,
+ *                           Arizona Board of Regents,
+ *                           Colorado State University,
+ *                           University Pierre & Marie Curie, Sorbonne University,
+ *                           Washington University in St. Louis,
+ *                           Beijing Institute of Technology,
+ *                           The University of Memphis.
+ *
+ * This file is part of NFD (Named Data Networking Forwarding Daemon).
+ * See AUTHORS.md for complete list of NFD authors and contributors.
+ *
+ * NFD is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * NFD is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * NFD, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "common.hpp"
+
+#ifdef HAVE_TPACKET_V3
+
+#include "ethernet-packet-ring.hpp"
+
+#include <cerrno>               // for errno
+#include <cstring>              // for std::strerror()
+#include <arpa/inet.h>          // for htons()
+#include <linux/if_packet.h>    // for TPACKET_V3 structures
+#include <sys/mman.h>           // for mmap()
+#include <sys/socket.h>         // for socket(), setsockopt(), bind(), send()
+#include <unistd.h>             // for close() and sysconf()
+
+namespace nfd {
+
+/// size of a receive block; a block is handed to userspace when full or retired
+static const size_t RX_BLOCK_SIZE = 1 << 20;
+static const size_t RX_BLOCK_COUNT = 8;
+/// a partially filled receive block is handed to userspace after this many milliseconds
+static const unsigned int RX_BLOCK_TIMEOUT = 1;
+static const size_t TX_FRAME_COUNT = 256;
+
+/// offset of frame data in a transmit slot, when PACKET_TX_HAS_OFF is not used
+static const size_t TX_DATA_OFFSET = TPACKET3_HDRLEN - sizeof(sockaddr_ll);
+
+static size_t
+roundUpToPowerOfTwo(size_t n)
+{
+  size_t result = 1;
+  while (result < n)
+    result <<= 1;
+  return result;
+}
+
+EthernetPacketRing::EthernetPacketRing(size_t maxFrameLength)
+  : m_fd(-1)
+  , m_map(nullptr)
+  , m_mapSize(0)
+  , m_rxRing(nullptr)
+  , m_rxBlockSize(RX_BLOCK_SIZE)
+  , m_rxBlockCount(RX_BLOCK_COUNT)
+  , m_rxBlockIndex(0)
+  , m_txRing(nullptr)
+  , m_txFrameIndex(0)
+  , m_nCommittedFrames(0)
+  , m_maxFrameLength(maxFrameLength)
+{
+  auto fail = [this] (const std::string& what) {
+    std::string msg = what + ": " + std::strerror(errno);
+    if (m_map != nullptr)
+      ::munmap(m_map, m_mapSize);
+    if (m_fd >= 0)
+      ::close(m_fd);
+    BOOST_THROW_EXCEPTION(Error(msg));
+  };
+
+  // protocol 0: no frame is queued to the socket before bind
+  m_fd = ::socket(AF_PACKET, SOCK_RAW, 0);
+  if (m_fd < 0)
+    fail("socket(AF_PACKET)");
+
+  int version = TPACKET_V3;
+  if (::setsockopt(m_fd, SOL_PACKET, PACKET_VERSION, &version, sizeof(version)) < 0)
+    fail("setsockopt(PACKET_VERSION)");
+
+  // the kernel discards a malformed frame and releases its slot; otherwise it would mark
+  // the slot TP_STATUS_WRONG_FORMAT and send no frame after it
+  int loss = 1;
+  if (::setsockopt(m_fd, SOL_PACKET, PACKET_LOSS, &loss, sizeof(loss)) < 0)
+    fail("setsockopt(PACKET_LOSS)");
+
+  size_t pageSize = static_cast<size_t>(::sysconf(_SC_PAGESIZE));
+  size_t frameSize = roundUpToPowerOfTwo(TPACKET3_HDRLEN + maxFrameLength);
+
+  tpacket_req3 rxReq{};
+  rxReq.tp_block_size = m_rxBlockSize;
+  rxReq.tp_block_nr = m_rxBlockCount;
+  rxReq.tp_frame_size = frameSize;
+  rxReq.tp_frame_nr = m_rxBlockSize / frameSize * m_rxBlockCount;
+  rxReq.tp_retire_blk_tov = RX_BLOCK_TIMEOUT;
+  if (::setsockopt(m_fd, SOL_PACKET, PACKET_RX_RING, &rxReq, sizeof(rxReq)) < 0)
+    fail("setsockopt(PACKET_RX_RING)");
+
+  // transmit slots have a fixed size, and a block holds a whole number of them
+  m_txFrameSize = frameSize;
+  size_t txBlockSize = std::max(frameSize, pageSize);
+  size_t txBlockCount = std::max<size_t>(TX_FRAME_COUNT * frameSize / txBlockSize, 1);
+  m_txFrameCount = txBlockSize / frameSize * txBlockCount;
+
+  tpacket_req3 txReq{};
+  txReq.tp_block_size = txBlockSize;
+  txReq.tp_block_nr = txBlockCount;
+  txReq.tp_frame_size = m_txFrameSize;
+  txReq.tp_frame_nr = m_txFrameCount;
+  if (::setsockopt(m_fd, SOL_PACKET, PACKET_TX_RING, &txReq, sizeof(txReq)) < 0)
+    fail("setsockopt(PACKET_TX_RING)");
+
+  // the receive ring is mapped first, followed by the transmit ring
+  size_t rxRingSize = m_rxBlockSize * m_rxBlockCount;
+  m_mapSize = rxRingSize + txBlockSize * txBlockCount;
+  void* map = ::mmap(nullptr, m_mapSize, PROT_READ | PROT_WRITE, MAP_SHARED, m_fd, 0);
+  if (map == MAP_FAILED)
+    fail("mmap");
+  m_map = static_cast<uint8_t*>(map);
+  m_rxRing = m_map;
+  m_txRing = m_map + rxRingSize;
+}
+
+EthernetPacketRing::~EthernetPacketRing()
+{
+  ::munmap(m_map, m_mapSize);
+  ::close(m_fd);
+}
+
+void
+EthernetPacketRing::bind(int interfaceIndex, uint16_t ethertype)
+{
+  sockaddr_ll addr{};
+  addr.sll_family = AF_PACKET;
+  addr.sll_protocol = htons(ethertype);
+  addr.sll_ifindex = interfaceIndex;
+  if (::bind(m_fd, reinterpret_cast<sockaddr*>(&addr), sizeof(addr)) < 0)
+    BOOST_THROW_EXCEPTION(Error("bind: " + std::string(std::strerror(errno))));
+}
+
+size_t
+EthernetPacketRing::receive(const FrameCallback& onFrame)
+{
+  size_t nFrames = 0;
+
+  // visit each block at most once, so that a busy link cannot starve other faces
+  for (size_t i = 0; i < m_rxBlockCount; ++i) {
+    auto block = reinterpret_cast<tpacket_block_desc*>(m_rxRing + m_rxBlockIndex * m_rxBlockSize);
+    if ((block->hdr.bh1.block_status & TP_STATUS_USER) == 0)
+      break;
+
+    // read the frames only after the kernel has released the block
+    __sync_synchronize();
+
+    uint32_t nPackets = block->hdr.bh1.num_pkts;
+    auto packet = reinterpret_cast<tpacket3_hdr*>(reinterpret_cast<uint8_t*>(block) +
+                                                  block->hdr.bh1.offset_to_first_pkt);
+    for (uint32_t j = 0; j < nPackets; ++j) {
+      onFrame(reinterpret_cast<const uint8_t*>(packet) + packet->tp_mac, packet->tp_snaplen);
+      packet = reinterpret_cast<tpacket3_hdr*>(reinterpret_cast<uint8_t*>(packet) +
+                                               packet->tp_next_offset);
+    }
+    nFrames += nPackets;
+
+    __sync_synchronize();
+    block->hdr.bh1.block_status = TP_STATUS_KERNEL;
+    m_rxBlockIndex = (m_rxBlockIndex + 1) % m_rxBlockCount;
+  }
+
+  return nFrames;
+}
+
+uint8_t*
+EthernetPacketRing::allocateFrame()
+{
+  auto header = reinterpret_cast<tpacket3_hdr*>(m_txRing + m_txFrameIndex * m_txFrameSize);
+  if (header->tp_status == TP_STATUS_WRONG_FORMAT) {
+    // not expected with PACKET_LOSS, but the kernel never releases such a slot itself
+    header->tp_status = TP_STATUS_AVAILABLE;
+  }
+  if (header->tp_status != TP_STATUS_AVAILABLE)
+    return nullptr;
+
+  return reinterpret_cast<uint8_t*>(header) + TX_DATA_OFFSET;
+}
+
+void
+EthernetPacketRing::commitFrame(size_t length)
+{
+  BOOST_ASSERT(length <= m_maxFrameLength);
+
+  auto header = reinterpret_cast<tpacket3_hdr*>(m_txRing + m_txFrameIndex * m_txFrameSize);
+  header->tp_len = length;
+  header->tp_next_offset = 0;
+
+  // the kernel may read the frame as soon as the status changes
+  __sync_synchronize();
+  header->tp_status = TP_STATUS_SEND_REQUEST;
+
+  m_txFrameIndex = (m_txFrameIndex + 1) % m_txFrameCount;
+  ++m_nCommittedFrames;
+}
+
+bool
+EthernetPacketRing::flush()
+{
+  if (m_nCommittedFrames == 0)
+    return true;
+
+  m_nCommittedFrames = 0;
+  return ::send(m_fd, nullptr, 0, MSG_DONTWAIT) >= 0 || errno == EAGAIN || errno == ENOBUFS;
+}
+
+} // namespace nfd
+
+#endif // HAVE_TPACKET_V3
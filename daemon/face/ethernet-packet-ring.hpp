@@ -0,0 +1,151 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2014-2015,  Regents of the University of California,
+ *                           Arizona Board of Regents,
+ *                           Colorado State University,
+ *                           University Pierre & Marie Curie, Sorbonne University,
+ *                           Washington University in St. Louis,
+ *                           Beijing Institute of Technology,
+ *                           The University of Memphis.
+ *
+ * This file is part of NFD (Named Data Networking Forwarding Daemon).
+ * See AUTHORS.md for complete list of NFD authors and contributors.
+ *
+ * NFD is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * NFD is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * NFD, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef NFD_DAEMON_FACE_ETHERNET_PACKET_RING_HPP
+#define NFD_DAEMON_FACE_ETHERNET_PACKET_RING_HPP
+
+#include "common.hpp"
+
+#ifndef HAVE_TPACKET_V3
+#error "Cannot include this file when TPACKET_V3 is not available"
+#endif
+
+namespace nfd {
+
+/**
+ * @brief AF_PACKET socket with TPACKET_V3 receive and transmit rings
+ *
+ * Both rings are memory-mapped, so that frames are read from and written to
+ * buffers shared with the kernel, without a copy through libpcap and without
+ * a system call per frame. Received frames are returned one block at a time;
+ * frames written to the transmit ring are sent together by flush().
+ */
+class EthernetPacketRing : noncopyable
+{
+public:
+  struct Error : public std::runtime_error
+  {
+    Error(const std::string& what) : std::runtime_error(what) {}
+  };
+
+  typedef function<void(const uint8_t* frame, size_t length)> FrameCallback;
+
+  /**
+   * @brief Opens a socket and sets up its rings
+   *
+   * The socket receives nothing until bind() is called, so that a packet filter
+   * can be attached first.
+   *
+   * @param maxFrameLength max length of a frame, including the link-layer header
+   * @throw Error if the socket or the rings cannot be set up
+   */
+  explicit
+  EthernetPacketRing(size_t maxFrameLength);
+
+  ~EthernetPacketRing();
+
+  /**
+   * @brief Starts receiving frames of the given ethertype on the given interface
+   *
+   * @throw Error if bind fails
+   */
+  void
+  bind(int interfaceIndex, uint16_t ethertype);
+
+  /**
+   * @brief Returns the socket, which is readable when a receive block is ready
+   */
+  int
+  getFd() const;
+
+  /**
+   * @brief Invokes onFrame for each frame in the receive blocks that are ready,
+   *        and returns the blocks to the kernel
+   *
+   * The frame pointer refers to the ring, and is valid only during the callback.
+   *
+   * @return number of frames received
+   */
+  size_t
+  receive(const FrameCallback& onFrame);
+
+  /**
+   * @brief Returns the buffer of the next free transmit slot, or nullptr if the
+   *        transmit ring is full
+   *
+   * Slots of malformed frames are released too, so they never block the ring.
+   *
+   * The frame is queued by commitFrame, and sent by the next flush.
+   */
+  uint8_t*
+  allocateFrame();
+
+  void
+  commitFrame(size_t length);
+
+  /**
+   * @brief Asks the kernel to send all committed frames, with one system call
+   *
+   * @return false if the kernel rejected the request
+   */
+  bool
+  flush();
+
+  size_t
+  getMaxFrameLength() const;
+
+private:
+  int m_fd;
+  uint8_t* m_map;
+  size_t m_mapSize;
+
+  uint8_t* m_rxRing;
+  size_t m_rxBlockSize;
+  size_t m_rxBlockCount;
+  size_t m_rxBlockIndex;
+
+  uint8_t* m_txRing;
+  size_t m_txFrameSize;
+  size_t m_txFrameCount;
+  size_t m_txFrameIndex;
+  size_t m_nCommittedFrames;
+  size_t m_maxFrameLength;
+};
+
+inline int
+EthernetPacketRing::getFd() const
+{
+  return m_fd;
+}
+
+inline size_t
+EthernetPacketRing::getMaxFrameLength() const
+{
+  return m_maxFrameLength;
+}
+
+} // namespace nfd
+
+#endif // NFD_DAEMON_FACE_ETHERNET_PACKET_RING_HPP
@@ -103,6 +103,42 @@ private:
   rep m_value;
 };
 
+/** \brief represents a counter of accumulated time
+ */
+// DurationCounter is noncopyable, because increment should be called on the counter,
+// not a copy of it; it's implicitly convertible to time::nanoseconds to be observed
+class DurationCounter : noncopyable
+{
+public:
+  typedef time::nanoseconds rep;
+
+  DurationCounter()
+    : m_value(rep::zero())
+  {
+  }
+
+  operator rep() const
+  {
+    return m_value;
+  }
+
+  DurationCounter&
+  operator+=(const rep& d)
+  {
+    m_value += d;
+    return *this;
+  }
+
+  void
+  set(const rep& value)
+  {
+    m_value = value;
+  }
+
+private:
+  rep m_value;
+};
+
 /** \brief contains network layer packet counters
  */
 class NetworkLayerCounters : noncopyable
@@ -229,9 +265,77 @@ private:
   ByteCounter m_nOutBytes;
 };
 
+/** \brief contains output queue counters
+ *
+ *  These are maintained by fw::TrafficManager.
+ *  They are not part of FaceStatus, and are not copied by FaceCounters::copyTo.
+ */
+class QueueCounters : noncopyable
+{
+public:
+  /// outgoing Data dropped by the output queue, either over the byte limit or by AQM
+  const PacketCounter&
+  getNOutDataDrops() const
+  {
+    return m_nOutDataDrops;
+  }
+
+  PacketCounter&
+  getNOutDataDrops()
+  {
+    return m_nOutDataDrops;
+  }
+
+  /// outgoing Data that waited in the output queue before being sent
+  const PacketCounter&
+  getNQueuedDatas() const
+  {
+    return m_nQueuedDatas;
+  }
+
+  PacketCounter&
+  getNQueuedDatas()
+  {
+    return m_nQueuedDatas;
+  }
+
+  /// outgoing Data marked as congested by the output queue
+  const PacketCounter&
+  getNOutCongestionMarks() const
+  {
+    return m_nOutCongestionMarks;
+  }
+
+  PacketCounter&
+  getNOutCongestionMarks()
+  {
+    return m_nOutCongestionMarks;
+  }
+
+  /// total time spent in the output queue by Data counted in getNQueuedDatas
+  const DurationCounter&
+  getQueueDelay() const
+  {
+    return m_queueDelay;
+  }
+
+  DurationCounter&
+  getQueueDelay()
+  {
+    return m_queueDelay;
+  }
+
+private:
+  PacketCounter m_nOutDataDrops;
+  PacketCounter m_nQueuedDatas;
+  PacketCounter m_nOutCongestionMarks;
+  DurationCounter m_queueDelay;
+};
+
 /** \brief contains counters on face
  */
-class FaceCounters : public NetworkLayerCounters, public LinkLayerCounters
+class FaceCounters : public NetworkLayerCounters, public LinkLayerCounters,
+                     public QueueCounters
 {
 public:
   /** \brief copy current obseverations to a struct
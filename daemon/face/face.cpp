@@ -24,9 +24,12 @@
  */
 
 #include "face.hpp"
+#include "congestion-mark-tag.hpp"
 
 #include <ndn-cxx/management/nfd-face-event-notification.hpp>
 
+#include <cstring> // for std::memcpy()
+
 namespace nfd {
 
 Face::Face(const FaceUri& remoteUri, const FaceUri& localUri, bool isLocal, bool isMultiAccess)
@@ -55,34 +58,161 @@ Face::isUp() const
   return true;
 }
 
+size_t
+Face::getSendQueueLength() const
+{
+  return 0;
+}
+
+ReceivedPacket::ReceivedPacket()
+  : nonce(0)
+  , hasSelectors(false)
+  , interestLifetime(-1)
+  , freshnessPeriod(-1)
+  , congestionMark(0)
+{
+}
+
+bool
+Face::decodeAndDispatchInput(const Block& element, uint64_t congestionMark)
+{
+  ReceivedPacket packet;
+  if (!this->decodeInput(element, congestionMark, packet))
+    return false;
+
+  return this->dispatchInput(packet);
+}
+
+size_t
+Face::decodeAndDispatchInput(const std::vector<Block>& elements)
+{
+  ReceiveBatch batch;
+  batch.reserve(elements.size());
+
+  size_t nInvalid = 0;
+  for (const Block& element : elements) {
+    batch.emplace_back();
+    if (!this->decodeInput(element, 0, batch.back())) {
+      batch.pop_back();
+      ++nInvalid;
+    }
+  }
+
+  if (batch.size() > 1)
+    this->beforeReceiveBatch(batch);
+
+  for (ReceivedPacket& packet : batch) {
+    if (!this->dispatchInput(packet))
+      ++nInvalid;
+  }
+  return nInvalid;
+}
+
 bool
-Face::decodeAndDispatchInput(const Block& element)
+Face::decodeInput(const Block& element, uint64_t congestionMark, ReceivedPacket& packet)
 {
   try {
-    /// \todo Ensure lazy field decoding process
+    packet.element = element;
+    packet.congestionMark = congestionMark;
+    return decodePacketHeader(element, packet);
+  }
+  catch (const tlv::Error&) {
+    return false;
+  }
+}
+
+bool
+Face::decodePacketHeader(const Block& wire, ReceivedPacket& packet)
+{
+  if (wire.type() != tlv::Interest && wire.type() != tlv::Data)
+    return false;
+
+  // parsing only records the boundaries of sub elements within the receive buffer.
+  // Name is parsed in place, so that packet.name and the Interest or Data decoded later
+  // share its components instead of parsing them again
+  packet.wire = wire;
+  packet.wire.parse();
+  const Block& name = packet.wire.get(tlv::Name);
+  name.parse();
+  packet.name.wireDecode(name);
+
+  if (wire.type() == tlv::Interest) {
+    const Block& nonce = packet.wire.get(tlv::Nonce);
+    if (nonce.value_size() == sizeof(uint32_t))
+      std::memcpy(&packet.nonce, nonce.value(), sizeof(uint32_t));
+    else
+      packet.nonce = static_cast<uint32_t>(ndn::readNonNegativeInteger(nonce));
+
+    packet.hasSelectors = packet.wire.find(tlv::Selectors) != packet.wire.elements_end();
+
+    Block::element_const_iterator lifetime = packet.wire.find(tlv::InterestLifetime);
+    if (lifetime != packet.wire.elements_end())
+      packet.interestLifetime = time::milliseconds(ndn::readNonNegativeInteger(*lifetime));
+  }
+  else {
+    Block::element_const_iterator metaInfo = packet.wire.find(tlv::MetaInfo);
+    if (metaInfo != packet.wire.elements_end()) {
+      metaInfo->parse();
+      Block::element_const_iterator freshness = metaInfo->find(tlv::FreshnessPeriod);
+      if (freshness != metaInfo->elements_end())
+        packet.freshnessPeriod = time::milliseconds(ndn::readNonNegativeInteger(*freshness));
+    }
+  }
 
-    if (element.type() == tlv::Interest)
+  return true;
+}
+
+bool
+Face::decodePacket(ReceivedPacket& packet)
+{
+  // packet.wire, including its Name and MetaInfo, is already parsed,
+  // so wireDecode only copies references to the parsed elements
+  try {
+    if (packet.wire.type() == tlv::Interest)
       {
-        shared_ptr<Interest> i = make_shared<Interest>();
-        i->wireDecode(element);
-        this->onReceiveInterest(*i);
+        packet.interest = make_shared<Interest>();
+        packet.interest->wireDecode(packet.wire);
       }
-    else if (element.type() == tlv::Data)
+    else
       {
-        shared_ptr<Data> d = make_shared<Data>();
-        d->wireDecode(element);
-        this->onReceiveData(*d);
+        packet.data = make_shared<Data>();
+        packet.data->wireDecode(packet.wire);
+        if (packet.congestionMark > 0) {
+          packet.data->setTag(make_shared<CongestionMarkTag>(packet.congestionMark));
+        }
       }
-    else
-      return false;
 
     return true;
   }
   catch (const tlv::Error&) {
+    packet.interest.reset();
+    packet.data.reset();
     return false;
   }
 }
 
+bool
+Face::dispatchInput(ReceivedPacket& packet)
+{
+  if (m_receiveFilter && !m_receiveFilter(packet)) {
+    // dropped before complete decoding, but still received
+    if (packet.wire.type() == tlv::Interest)
+      ++m_counters.getNInInterests();
+    else
+      ++m_counters.getNInDatas();
+    return true;
+  }
+
+  if (!this->decodePacket(packet))
+    return false;
+
+  if (packet.interest != nullptr)
+    this->onReceiveInterest(*packet.interest);
+  else
+    this->onReceiveData(*packet.data);
+  return true;
+}
+
 void
 Face::fail(const std::string& reason)
 {
@@ -34,6 +34,10 @@
 
 namespace nfd {
 
+namespace fw {
+class TrafficManager;
+} // namespace fw
+
 /** \class FaceId
  *  \brief identifies a face
  */
@@ -51,6 +55,41 @@ const FaceId FACEID_NULL = 255;
 /// upper bound of reserved FaceIds
 const FaceId FACEID_RESERVED_MAX = 255;
 
+/** \brief a network layer packet received by a face
+ *
+ *  A face first decodes only the fields that the forwarding pipelines need up front.
+ *  They refer to the receive buffer and are not copied. The complete Interest or Data
+ *  is decoded when the packet is dispatched, unless the receive filter drops it.
+ */
+struct ReceivedPacket
+{
+  ReceivedPacket();
+
+  /// element as received, which is either wire or a LocalControlHeader around it
+  Block element;
+  /// Interest or Data TLV block, with its sub elements parsed
+  Block wire;
+  Name name;
+  /// Nonce of Interest
+  uint32_t nonce;
+  /// whether Interest has Selectors
+  bool hasSelectors;
+  /// InterestLifetime of Interest, or -1 if absent
+  time::milliseconds interestLifetime;
+  /// FreshnessPeriod of Data, or -1 if absent
+  time::milliseconds freshnessPeriod;
+  /// congestion mark carried by the link protocol
+  uint64_t congestionMark;
+
+  /// complete Interest; set when the packet is dispatched
+  shared_ptr<Interest> interest;
+  /// complete Data; set when the packet is dispatched
+  shared_ptr<Data> data;
+};
+
+/** \brief network layer packets decoded from one receive operation, in arrival order
+ */
+typedef std::vector<ReceivedPacket> ReceiveBatch;
 
 /** \brief represents a face
  */
@@ -76,12 +115,45 @@ public:
   virtual
   ~Face();
 
-  /// fires when an Interest is received
+  /** \brief fires when an Interest is received
+   *
+   *  It does not fire for an Interest dropped by the receive filter, see setReceiveFilter.
+   */
   signal::Signal<Face, Interest> onReceiveInterest;
 
-  /// fires when a Data is received
+  /** \brief fires when a Data is received
+   *
+   *  It does not fire for a Data dropped by the receive filter, see setReceiveFilter.
+   */
   signal::Signal<Face, Data> onReceiveData;
 
+  /** \brief fires when more than one packet was decoded from one receive operation,
+   *         before onReceiveInterest and onReceiveData fire for each of them in order
+   *
+   *  This allows the forwarder to prepare its tables for the whole batch; packets are
+   *  still processed one at a time.
+   */
+  signal::Signal<Face, ReceiveBatch> beforeReceiveBatch;
+
+  /** \brief decides whether a received packet enters the forwarding pipelines
+   *  \return false to drop the packet before it is decoded completely
+   *
+   *  The filter only sees the fields of ReceivedPacket that are decoded up front.
+   */
+  typedef function<bool(const ReceivedPacket& packet)> ReceiveFilter;
+
+  /** \brief set the filter applied to each received packet before it is dispatched
+   *
+   *  Packets dropped by the filter are counted as received, but neither
+   *  onReceiveInterest nor onReceiveData fires for them, because firing either signal
+   *  requires the complete packet. Observers of those signals, such as packet tracers,
+   *  therefore do not see packets that the forwarder would drop on arrival anyway:
+   *  /localhost violations, Interests looping by the Dead Nonce List, and unsolicited
+   *  Data from non-local faces. Use the face counters to account for them.
+   */
+  void
+  setReceiveFilter(const ReceiveFilter& filter);
+
   /// fires when an Interest is sent out
   signal::Signal<Face, Interest> onSendInterest;
 
@@ -91,6 +163,13 @@ public:
   /// fires when face disconnects or fails to perform properly
   signal::Signal<Face, std::string/*reason*/> onFail;
 
+  /** \brief fires when a packet buffered inside the face has been handed to the transport
+   *
+   *  Faces that override getSendQueueLength must emit this signal whenever the length
+   *  decreases, so that fw::TrafficManager can release more packets to the face.
+   */
+  signal::Signal<Face> onTransmitComplete;
+
   /// send an Interest
   virtual void
   sendInterest(const Interest& interest) = 0;
@@ -151,6 +230,15 @@ public: // attributes
   virtual bool
   isUp() const;
 
+  /** \return number of bytes accepted by sendInterest/sendData but not yet
+   *          handed to the transport
+   *
+   *  In this base class this is always zero, meaning the face never builds a backlog
+   *  of its own and fw::TrafficManager passes packets straight through.
+   */
+  virtual size_t
+  getSendQueueLength() const;
+
   const FaceCounters&
   getCounters() const;
 
@@ -180,8 +268,47 @@ PUBLIC_WITH_TESTS_ELSE_PROTECTED:
   setPersistency(ndn::nfd::FacePersistency persistency);
 
 protected:
+  /** \brief decode a network layer packet and emit onReceiveInterest or onReceiveData
+   *  \param congestionMark congestion mark carried by the link protocol;
+   *         if non-zero, a received Data is tagged with CongestionMarkTag
+   */
+  bool
+  decodeAndDispatchInput(const Block& element, uint64_t congestionMark = 0);
+
+  /** \brief decode network layer packets received in one operation, then emit
+   *         beforeReceiveBatch, and onReceiveInterest or onReceiveData for each packet
+   *  \return number of elements that are not a valid Interest or Data; they are skipped
+   */
+  size_t
+  decodeAndDispatchInput(const std::vector<Block>& elements);
+
+  /** \brief decode the fields of a network layer packet needed up front into packet
+   *  \return false if element is not an Interest or Data
+   */
+  virtual bool
+  decodeInput(const Block& element, uint64_t congestionMark, ReceivedPacket& packet);
+
+  /** \brief decode the complete Interest or Data of packet
+   *  \return false if packet is not a valid Interest or Data
+   */
+  virtual bool
+  decodePacket(ReceivedPacket& packet);
+
+  /** \brief decode Name, Nonce, Selectors presence, InterestLifetime, and FreshnessPeriod
+   *         of an Interest or Data TLV block into packet, without copying it
+   *  \return false if wire is neither an Interest nor a Data
+   *  \throw tlv::Error if a required field is missing or malformed
+   */
+  static bool
+  decodePacketHeader(const Block& wire, ReceivedPacket& packet);
+
+private:
+  /** \return false if packet cannot be decoded completely
+   */
   bool
-  decodeAndDispatchInput(const Block& element);
+  dispatchInput(ReceivedPacket& packet);
+
+protected:
 
   /** \brief fail the face and raise onFail event if it's UP; otherwise do nothing
    */
@@ -195,6 +322,7 @@ protected:
   DECLARE_SIGNAL_EMIT(onReceiveData)
   DECLARE_SIGNAL_EMIT(onSendInterest)
   DECLARE_SIGNAL_EMIT(onSendData)
+  DECLARE_SIGNAL_EMIT(onTransmitComplete)
 
 private:
   // this method should be used only by the FaceTable
@@ -212,9 +340,12 @@ private:
   const bool m_isMultiAccess;
   bool m_isFailed;
   uint64_t m_metric;
+  ReceiveFilter m_receiveFilter;
 
   // allow setting FaceId
   friend class FaceTable;
+  // allow updating queue counters
+  friend class fw::TrafficManager;
 };
 
 inline FaceId
@@ -299,6 +430,12 @@ Face::getLocalUri() const
  * @{
  */
 
+inline void
+Face::setReceiveFilter(const ReceiveFilter& filter)
+{
+  m_receiveFilter = filter;
+}
+
 inline void
 Face::setMetric(uint64_t metric)
 {
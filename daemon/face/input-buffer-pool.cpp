@@ -0,0 +1,77 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2014-2015,  Regents of the University of California,
+ *                           Arizona Board of Regents,
+ *                           Colorado State University,
+ *                           University Pierre & Marie Curie, Sorbonne University,
+ *                           Washington University in St. Louis,
+ *                           Beijing Institute of Technology,
+ *                           The University of Memphis.
+ *
+ * This file is part of NFD (Named Data Networking Forwarding Daemon).
+ * See AUTHORS.md for complete list of NFD authors and contributors.
+ *
+ * NFD is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * NFD is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * NFD, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+#include "input-buffer-pool.hpp"
+
+namespace nfd {
+
+const size_t InputBufferPool::BUFFER_SIZE;
+const size_t InputBufferPool::DEFAULT_MAX_IDLE;
+
+InputBufferPool::Lease::Lease(InputBufferPool& pool)
+  : m_pool(pool)
+  , m_buffer(pool.acquire())
+{
+}
+
+InputBufferPool::Lease::~Lease()
+{
+  m_pool.release(std::move(m_buffer));
+}
+
+InputBufferPool::InputBufferPool(size_t maxIdle)
+  : m_maxIdle(maxIdle)
+{
+}
+
+InputBufferPool::Buffer
+InputBufferPool::acquire()
+{
+  if (m_idle.empty()) {
+    return Buffer(new uint8_t[BUFFER_SIZE]);
+  }
+
+  Buffer buffer = std::move(m_idle.back());
+  m_idle.pop_back();
+  return buffer;
+}
+
+void
+InputBufferPool::release(Buffer buffer)
+{
+  if (buffer != nullptr && m_idle.size() < m_maxIdle) {
+    m_idle.push_back(std::move(buffer));
+  }
+}
+
+InputBufferPool&
+getGlobalInputBufferPool()
+{
+  static InputBufferPool pool;
+  return pool;
+}
+
+} // namespace nfd
@@ -0,0 +1,114 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2014-2015,  Regents of the University of California,
+ *                           Arizona Board of Regents,
+ *                           Colorado State University,
+ *                           University Pierre & Marie Curie, Sorbonne University,
+ *                           Washington University in St. Louis,
+ *                           Beijing Institute of Technology,
+ *                           The University of Memphis.
+ *
+ * This file is part of NFD (Named Data Networking Forwarding Daemon).
+ * See AUTHORS.md for complete list of NFD authors and contributors.
+ *
+ * NFD is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * NFD is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * NFD, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+#ifndef NFD_DAEMON_FACE_INPUT_BUFFER_POOL_HPP
+#define NFD_DAEMON_FACE_INPUT_BUFFER_POOL_HPP
+
+#include "common.hpp"
+
+namespace nfd {
+
+/** \brief pool of receive buffers shared by all socket faces
+ *
+ *  A face does not own a receive buffer. It waits for its socket to become readable,
+ *  then leases a buffer from the pool for the duration of one read, and returns it
+ *  before waiting again. Since handlers run one at a time, a handful of buffers serve
+ *  any number of faces, and idle faces hold none.
+ */
+class InputBufferPool : noncopyable
+{
+public:
+  /// size of each buffer, large enough for any NDN packet
+  static const size_t BUFFER_SIZE = ndn::MAX_NDN_PACKET_SIZE;
+
+  /// default number of idle buffers kept for reuse
+  static const size_t DEFAULT_MAX_IDLE = 16;
+
+  typedef std::unique_ptr<uint8_t[]> Buffer;
+
+  /** \brief a buffer borrowed from the pool, returned when the Lease is destroyed
+   */
+  class Lease : noncopyable
+  {
+  public:
+    explicit
+    Lease(InputBufferPool& pool);
+
+    ~Lease();
+
+    uint8_t*
+    get() const;
+
+  private:
+    InputBufferPool& m_pool;
+    Buffer m_buffer;
+  };
+
+  explicit
+  InputBufferPool(size_t maxIdle = DEFAULT_MAX_IDLE);
+
+  /** \brief take a buffer from the pool, or allocate one if none is idle
+   */
+  Buffer
+  acquire();
+
+  /** \brief return a buffer to the pool
+   *
+   *  The buffer is freed if the pool already holds maxIdle buffers.
+   */
+  void
+  release(Buffer buffer);
+
+  /** \return number of idle buffers in the pool
+   */
+  size_t
+  size() const;
+
+private:
+  size_t m_maxIdle;
+  std::vector<Buffer> m_idle;
+};
+
+inline uint8_t*
+InputBufferPool::Lease::get() const
+{
+  return m_buffer.get();
+}
+
+inline size_t
+InputBufferPool::size() const
+{
+  return m_idle.size();
+}
+
+/** \return the pool used by socket faces
+ */
+InputBufferPool&
+getGlobalInputBufferPool();
+
+} // namespace nfd
+
+#endif // NFD_DAEMON_FACE_INPUT_BUFFER_POOL_HPP
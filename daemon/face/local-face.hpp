@@ -71,15 +71,22 @@ public:
   static const size_t LOCAL_CONTROL_FEATURE_ANY = 0; /// any feature
 
 protected:
-  // statically overridden from Face
+  // overridden from Face
 
-  /** \brief Decode block into Interest/Data, considering potential LocalControlHeader
+  /** \brief Decode fields of Interest/Data needed up front, considering potential
+   *         LocalControlHeader
    *
    *  If LocalControlHeader is present, the encoded data is filtered out, based
-   *  on enabled features on the face.
+   *  on enabled features on the face, when the packet is decoded completely.
    */
   bool
-  decodeAndDispatchInput(const Block& element);
+  decodeInput(const Block& element, uint64_t congestionMark,
+              ReceivedPacket& packet) DECL_OVERRIDE;
+
+  /** \brief Decode complete Interest/Data, and the LocalControlHeader of an Interest
+   */
+  bool
+  decodePacket(ReceivedPacket& packet) DECL_OVERRIDE;
 
   // LocalFace-specific methods
 
@@ -137,7 +144,7 @@ LocalFace::setLocalControlHeaderFeature(LocalControlFeature feature, bool enable
 }
 
 inline bool
-LocalFace::decodeAndDispatchInput(const Block& element)
+LocalFace::decodeInput(const Block& element, uint64_t congestionMark, ReceivedPacket& packet)
 {
   try {
     const Block& payload = ndn::nfd::LocalControlHeader::getPayload(element);
@@ -146,49 +153,42 @@ LocalFace::decodeAndDispatchInput(const Block& element)
     if ((&payload != &element) && !this->isLocalControlHeaderEnabled())
       return false;
 
-    if (payload.type() == tlv::Interest)
-      {
-        shared_ptr<Interest> i = make_shared<Interest>();
-        i->wireDecode(payload);
-        if (&payload != &element)
-          {
-            uint8_t mask = 0;
-            if (this->isLocalControlHeaderEnabled(LOCAL_CONTROL_FEATURE_NEXT_HOP_FACE_ID)) {
-              mask |= ndn::nfd::LocalControlHeader::ENCODE_NEXT_HOP;
-            }
-            i->getLocalControlHeader().wireDecode(element, mask);
-          }
-
-        this->emitSignal(onReceiveInterest, *i);
-      }
-    else if (payload.type() == tlv::Data)
-      {
-        shared_ptr<Data> d = make_shared<Data>();
-        d->wireDecode(payload);
-
-        /// \todo Uncomment and correct the following when we have more
-        ///       options in LocalControlHeader that apply for incoming
-        ///       Data packets (if ever)
-        // if (&payload != &element)
-        //   {
-        //
-        //     d->getLocalControlHeader().wireDecode(element,
-        //       false,
-        //       false);
-        //   }
-
-        this->emitSignal(onReceiveData, *d);
-      }
-    else
-      return false;
-
-    return true;
+    packet.element = element;
+    return decodePacketHeader(payload, packet);
   }
   catch (const tlv::Error&) {
     return false;
   }
 }
 
+inline bool
+LocalFace::decodePacket(ReceivedPacket& packet)
+{
+  if (!Face::decodePacket(packet))
+    return false;
+
+  // LocalControlHeader is present if the received element is not the packet itself
+  if (packet.interest != nullptr && packet.element.type() != tlv::Interest)
+    {
+      try {
+        uint8_t mask = 0;
+        if (this->isLocalControlHeaderEnabled(LOCAL_CONTROL_FEATURE_NEXT_HOP_FACE_ID)) {
+          mask |= ndn::nfd::LocalControlHeader::ENCODE_NEXT_HOP;
+        }
+        packet.interest->getLocalControlHeader().wireDecode(packet.element, mask);
+      }
+      catch (const tlv::Error&) {
+        packet.interest.reset();
+        return false;
+      }
+    }
+
+  /// \todo Decode LocalControlHeader of incoming Data when we have options
+  ///       in LocalControlHeader that apply for them (if ever)
+
+  return true;
+}
+
 inline bool
 LocalFace::isEmptyFilteredLocalControlHeader(const ndn::nfd::LocalControlHeader& header) const
 {
@@ -62,12 +62,23 @@ NdnlpData::fromBlock(const Block& wire)
   }
   parsed.payload = payloadElement;
 
-  if (elements.size() == 2) { // single wire packet
+  // optional NdnlpCongestionMark immediately precedes NdnlpPayload
+  size_t nElements = elements.size();
+  const Block& markElement = elements.at(nElements - 2);
+  if (markElement.type() == tlv::NdnlpCongestionMark) {
+    parsed.congestionMark = ndn::readNonNegativeInteger(markElement);
+    --nElements;
+  }
+  else {
+    parsed.congestionMark = 0;
+  }
+
+  if (nElements == 2) { // single wire packet
     parsed.fragIndex = 0;
     parsed.fragCount = 1;
     return std::make_tuple(true, parsed);
   }
-  if (elements.size() != 4) {
+  if (nElements != 4) {
     // NdnlpData element has incorrect number of children
     return std::make_tuple(false, NdnlpData());
   }
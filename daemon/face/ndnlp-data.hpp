@@ -53,6 +53,8 @@ public:
   uint64_t seq;
   uint16_t fragIndex;
   uint16_t fragCount;
+  /// congestion mark, 0 if absent
+  uint64_t congestionMark;
   Block payload;
 };
 
@@ -32,8 +32,10 @@ namespace ndnlp {
 NFD_LOG_INIT("NdnlpPartialMessageStore");
 
 PartialMessage::PartialMessage()
-  : m_fragCount(0)
+  : congestionMark(0)
+  , m_fragCount(0)
   , m_received(0)
+  , m_fragmentSize(0)
   , m_totalLength(0)
 {
 }
@@ -43,20 +45,63 @@ PartialMessage::add(uint16_t fragIndex, uint16_t fragCount, const Block& payload
 {
   if (m_received == 0) { // first packet
     m_fragCount = fragCount;
-    m_payloads.resize(fragCount);
+    m_hasFragment.assign(fragCount, false);
   }
 
   if (m_fragCount != fragCount || fragIndex >= m_fragCount) {
     return false;
   }
 
-  if (!m_payloads[fragIndex].empty()) { // duplicate
+  if (m_hasFragment[fragIndex]) { // duplicate
     return false;
   }
 
-  m_payloads[fragIndex] = payload;
+  size_t payloadSize = payload.value_size();
+  if (payloadSize == 0) {
+    return false;
+  }
+
+  bool isLast = fragIndex == m_fragCount - 1;
+  if (isLast && m_buffer == nullptr) {
+    if (payloadSize >= ndn::MAX_NDN_PACKET_SIZE) {
+      return false;
+    }
+    // the offset of the last fragment is unknown until another fragment arrives
+    m_lastPayload = payload;
+  }
+  else {
+    if (m_buffer == nullptr) {
+      // the last fragment is not empty, so a larger message cannot be a valid packet
+      if ((m_fragCount - 1) * payloadSize >= ndn::MAX_NDN_PACKET_SIZE) {
+        return false;
+      }
+      m_fragmentSize = payloadSize;
+      m_buffer = make_shared<ndn::Buffer>(m_fragCount * m_fragmentSize);
+
+      if (!m_lastPayload.empty()) {
+        if (m_lastPayload.value_size() <= m_fragmentSize) {
+          std::copy(m_lastPayload.value_begin(), m_lastPayload.value_end(),
+                    m_buffer->begin() + (m_fragCount - 1) * m_fragmentSize);
+        }
+        else { // inconsistent with this fragment, drop it
+          m_hasFragment.back() = false;
+          --m_received;
+          m_totalLength -= m_lastPayload.value_size();
+        }
+        m_lastPayload = Block();
+      }
+    }
+
+    if (isLast ? payloadSize > m_fragmentSize : payloadSize != m_fragmentSize) {
+      return false;
+    }
+    std::copy(payload.value_begin(), payload.value_end(),
+              m_buffer->begin() + fragIndex * m_fragmentSize);
+  }
+
+  m_hasFragment[fragIndex] = true;
   ++m_received;
-  m_totalLength += payload.value_size();
+  m_totalLength += payloadSize;
   return true;
 }
 
@@ -70,15 +115,11 @@ std::tuple<bool, Block>
 PartialMessage::reassemble()
 {
   BOOST_ASSERT(this->isComplete());
+  BOOST_ASSERT(m_buffer != nullptr);
 
-  ndn::BufferPtr buffer = make_shared<ndn::Buffer>(m_totalLength);
-  ndn::Buffer::iterator buf = buffer->begin();
-  for (const Block& payload : m_payloads) {
-    buf = std::copy(payload.value_begin(), payload.value_end(), buf);
-  }
-  BOOST_ASSERT(buf == buffer->end());
-
-  return Block::fromBuffer(buffer, 0);
+  // the last fragment may be shorter than the others
+  m_buffer->resize(m_totalLength);
+  return Block::fromBuffer(m_buffer, 0);
 }
 
 std::tuple<bool, Block>
@@ -94,32 +135,61 @@ PartialMessage::reassembleSingle(const NdnlpData& fragment)
   }
 }
 
-PartialMessageStore::PartialMessageStore(const time::nanoseconds& idleDuration)
-  : m_idleDuration(idleDuration)
+const size_t PartialMessageStore::DEFAULT_MAX_BYTES = 4 * 1024 * 1024;
+
+PartialMessageStore::PartialMessageStore(const time::nanoseconds& idleDuration,
+                                         size_t maxBytes)
+  : m_nBytes(0)
+  , m_maxBytes(maxBytes)
+  , m_idleDuration(idleDuration)
+  , m_isSweepScheduled(false)
 {
 }
 
 void
-PartialMessageStore::receive(const NdnlpData& pkt)
+PartialMessageStore::receive(const NdnlpData& pkt, uint64_t senderId)
 {
   bool isReassembled = false;
   Block reassembled;
+  uint64_t congestionMark = pkt.congestionMark;
 
   if (pkt.fragCount == 1) { // single fragment
     std::tie(isReassembled, reassembled) = PartialMessage::reassembleSingle(pkt);
   }
   else {
-    uint64_t messageIdentifier = pkt.seq - pkt.fragIndex;
-    PartialMessage& pm = m_partialMessages[messageIdentifier];
-    this->scheduleCleanup(messageIdentifier, pm);
+    MessageKey key(senderId, pkt.seq - pkt.fragIndex);
+    auto it = m_partialMessages.find(key);
+    if (it == m_partialMessages.end()) {
+      it = m_partialMessages.emplace(key, Entry()).first;
+      it->second.queuePosition = m_queue.insert(m_queue.end(), key);
+    }
+    else {
+      m_queue.splice(m_queue.end(), m_queue, it->second.queuePosition);
+    }
+    it->second.lastActivity = time::steady_clock::now();
 
-    pm.add(pkt.fragIndex, pkt.fragCount, pkt.payload);
+    PartialMessage& pm = it->second.message;
+    size_t oldUsage = pm.getMemoryUsage();
+    if (pm.add(pkt.fragIndex, pkt.fragCount, pkt.payload)) {
+      pm.congestionMark = std::max(pm.congestionMark, pkt.congestionMark);
+    }
+    m_nBytes = m_nBytes - oldUsage + pm.getMemoryUsage();
 
     if (pm.isComplete()) {
       std::tie(isReassembled, reassembled) = pm.reassemble();
-      m_partialMessages.erase(messageIdentifier);
+      congestionMark = pm.congestionMark;
+      this->erase(it);
     }
     else {
+      // the message just updated is at the back, so it is dropped last
+      while (m_nBytes > m_maxBytes) {
+        NFD_LOG_TRACE(m_queue.front().second << " evict");
+        this->erase(m_partialMessages.find(m_queue.front()));
+      }
+
+      if (!m_isSweepScheduled && !m_partialMessages.empty()) {
+        this->scheduleSweep(m_idleDuration);
+      }
       return;
     }
   }
@@ -130,22 +200,42 @@ PartialMessageStore::receive(const NdnlpData& pkt)
   }
 
   NFD_LOG_TRACE(pkt.seq << " deliver");
-  this->onReceive(reassembled);
+  this->onReceive(reassembled, congestionMark);
 }
 
 void
-PartialMessageStore::scheduleCleanup(uint64_t messageIdentifier,
-                                     PartialMessage& partialMessage)
+PartialMessageStore::erase(MessageMap::iterator it)
 {
-  partialMessage.expiry = scheduler::schedule(m_idleDuration,
-    bind(&PartialMessageStore::cleanup, this, messageIdentifier));
+  m_nBytes -= it->second.message.getMemoryUsage();
+  m_queue.erase(it->second.queuePosition);
+  m_partialMessages.erase(it);
+}
+
+void
+PartialMessageStore::sweep()
+{
+  m_isSweepScheduled = false;
+
+  time::steady_clock::TimePoint now = time::steady_clock::now();
+  while (!m_queue.empty()) {
+    auto it = m_partialMessages.find(m_queue.front());
+    time::steady_clock::TimePoint expiry = it->second.lastActivity + m_idleDuration;
+    if (expiry > now) {
+      // wake up when the least recently active message expires
+      this->scheduleSweep(expiry - now);
+      return;
+    }
+
+    NFD_LOG_TRACE(it->first.second << " cleanup");
+    this->erase(it);
+  }
 }
 
 void
-PartialMessageStore::cleanup(uint64_t messageIdentifier)
+PartialMessageStore::scheduleSweep(const time::nanoseconds& after)
 {
-  NFD_LOG_TRACE(messageIdentifier << " cleanup");
-  m_partialMessages.erase(messageIdentifier);
+  m_isSweepScheduled = true;
+  m_sweepEvent = scheduler::schedule(after, bind(&PartialMessageStore::sweep, this));
 }
 
 } // namespace ndnlp
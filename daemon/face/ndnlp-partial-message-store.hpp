@@ -33,6 +33,10 @@ namespace nfd {
 namespace ndnlp {
 
 /** \brief represents a partially received message
+ *
+ *  Fragments are written at their offsets in a single buffer, which becomes the
+ *  buffer of the reassembled packet. Every fragment but the last carries the same
+ *  payload size, so the buffer is sized from FragCount and the first such fragment.
  */
 class PartialMessage
 {
@@ -49,6 +53,9 @@ public:
   PartialMessage&
   operator=(PartialMessage&&) = default;
 
+  /** \return whether the fragment is accepted; a fragment is rejected if it is
+   *          a duplicate, or inconsistent with fragments received earlier
+   */
   bool
   add(uint16_t fragIndex, uint16_t fragCount, const Block& payload);
 
@@ -69,48 +76,131 @@ public:
   static std::tuple<bool, Block>
   reassembleSingle(const NdnlpData& fragment);
 
+  /** \return{ number of bytes held by this message }
+   */
+  size_t
+  getMemoryUsage() const;
+
 public:
-  scheduler::ScopedEventId expiry;
+  /// congestion mark carried by any fragment, 0 if none
+  uint64_t congestionMark;
 
 private:
   size_t m_fragCount;
   size_t m_received;
-  std::vector<Block> m_payloads;
+  std::vector<bool> m_hasFragment;
+
+  /// payload size of every fragment but the last, 0 until known
+  size_t m_fragmentSize;
+  ndn::BufferPtr m_buffer;
+  /// last fragment, kept until m_buffer is allocated
+  Block m_lastPayload;
   size_t m_totalLength;
 };
 
 /** \brief provides reassembly feature at receiver
+ *
+ *  Memory held by partial messages is bounded: when it exceeds the limit, the
+ *  messages that have been idle the longest are dropped first. Idle messages
+ *  are also dropped after idleDuration, by a single timer per store.
  */
 class PartialMessageStore : noncopyable
 {
 public:
+  /// default max number of bytes held by partial messages
+  static const size_t DEFAULT_MAX_BYTES;
+
   explicit
-  PartialMessageStore(const time::nanoseconds& idleDuration = time::milliseconds(100));
+  PartialMessageStore(const time::nanoseconds& idleDuration = time::milliseconds(100),
+                      size_t maxBytes = DEFAULT_MAX_BYTES);
 
   /** \brief receive a NdnlpData packet
+   *  \param senderId identifies the sender, when the store is shared by several senders
    *
    *  Reassembly errors will be ignored.
    */
   void
-  receive(const NdnlpData& pkt);
+  receive(const NdnlpData& pkt, uint64_t senderId = 0);
+
+  /** \return{ number of partial messages }
+   */
+  size_t
+  size() const;
+
+  /** \return{ number of bytes held by partial messages }
+   */
+  size_t
+  getMemoryUsage() const;
 
-  /** \brief fires when network layer packet is received
+  /** \brief fires when network layer packet is received,
+   *         with its congestion mark (0 if not marked)
    */
-  signal::Signal<PartialMessageStore, Block> onReceive;
+  signal::Signal<PartialMessageStore, Block, uint64_t> onReceive;
 
 private:
+  /// sender and message identifier
+  typedef std::pair<uint64_t, uint64_t> MessageKey;
+
+  struct MessageKeyHash
+  {
+    size_t
+    operator()(const MessageKey& key) const
+    {
+      return std::hash<uint64_t>()(key.first * 0x9e3779b97f4a7c15ULL ^ key.second);
+    }
+  };
+
+  struct Entry
+  {
+    PartialMessage message;
+    time::steady_clock::TimePoint lastActivity;
+    std::list<MessageKey>::iterator queuePosition;
+  };
+
+  typedef std::unordered_map<MessageKey, Entry, MessageKeyHash> MessageMap;
+
+  void
+  erase(MessageMap::iterator it);
+
+  /** \brief drop messages that have been idle for idleDuration
+   */
   void
-  scheduleCleanup(uint64_t messageIdentifier, PartialMessage& partialMessage);
+  sweep();
 
   void
-  cleanup(uint64_t messageIdentifier);
+  scheduleSweep(const time::nanoseconds& after);
 
 private:
-  std::unordered_map<uint64_t, PartialMessage> m_partialMessages;
+  MessageMap m_partialMessages;
+  /// keys of partial messages, the least recently active first
+  std::list<MessageKey> m_queue;
+
+  size_t m_nBytes;
+  size_t m_maxBytes;
 
   time::nanoseconds m_idleDuration;
+  scheduler::ScopedEventId m_sweepEvent;
+  bool m_isSweepScheduled;
 };
 
+inline size_t
+PartialMessage::getMemoryUsage() const
+{
+  return m_buffer != nullptr ? m_buffer->size() : m_lastPayload.size();
+}
+
+inline size_t
+PartialMessageStore::size() const
+{
+  return m_partialMessages.size();
+}
+
+inline size_t
+PartialMessageStore::getMemoryUsage() const
+{
+  return m_nBytes;
+}
+
 } // namespace ndnlp
 } // namespace nfd
 
@@ -30,6 +30,86 @@
 namespace nfd {
 namespace ndnlp {
 
+/** \brief prepends TLV fields into a fixed-size buffer, with the interface
+ *         of ndn::EncodingImpl used by Slicer::encodeHeader
+ */
+class HeaderEncoder : noncopyable
+{
+public:
+  HeaderEncoder(uint8_t* buffer, size_t capacity)
+    : m_begin(buffer)
+    , m_pos(buffer + capacity)
+  {
+  }
+
+  size_t
+  prependByteArray(const uint8_t* array, size_t length)
+  {
+    BOOST_ASSERT(static_cast<size_t>(m_pos - m_begin) >= length);
+    m_pos -= length;
+    std::copy(array, array + length, m_pos);
+    return length;
+  }
+
+  size_t
+  prependVarNumber(uint64_t varNumber)
+  {
+    if (varNumber < 253) {
+      return this->prependBigEndian(varNumber, 1);
+    }
+    else if (varNumber <= std::numeric_limits<uint16_t>::max()) {
+      return this->prependBigEndian(varNumber, 2) + this->prependBigEndian(253, 1);
+    }
+    else if (varNumber <= std::numeric_limits<uint32_t>::max()) {
+      return this->prependBigEndian(varNumber, 4) + this->prependBigEndian(254, 1);
+    }
+    else {
+      return this->prependBigEndian(varNumber, 8) + this->prependBigEndian(255, 1);
+    }
+  }
+
+  size_t
+  prependNonNegativeInteger(uint64_t integer)
+  {
+    if (integer <= std::numeric_limits<uint8_t>::max()) {
+      return this->prependBigEndian(integer, 1);
+    }
+    else if (integer <= std::numeric_limits<uint16_t>::max()) {
+      return this->prependBigEndian(integer, 2);
+    }
+    else if (integer <= std::numeric_limits<uint32_t>::max()) {
+      return this->prependBigEndian(integer, 4);
+    }
+    else {
+      return this->prependBigEndian(integer, 8);
+    }
+  }
+
+  /** \return{ offset of the encoded fields in the buffer }
+   */
+  size_t
+  getOffset() const
+  {
+    return m_pos - m_begin;
+  }
+
+private:
+  size_t
+  prependBigEndian(uint64_t value, size_t length)
+  {
+    BOOST_ASSERT(static_cast<size_t>(m_pos - m_begin) >= length);
+    for (size_t i = 0; i < length; ++i) {
+      *--m_pos = static_cast<uint8_t>(value);
+      value >>= 8;
+    }
+    return length;
+  }
+
+private:
+  uint8_t* m_begin;
+  uint8_t* m_pos;
+};
+
 Slicer::Slicer(size_t mtu)
   : m_mtu(mtu)
 {
@@ -40,67 +120,75 @@ Slicer::~Slicer()
 {
 }
 
-template<bool T>
+template<class Encoder>
 size_t
-Slicer::encodeFragment(ndn::EncodingImpl<T>& blk,
-                       uint64_t seq, uint16_t fragIndex, uint16_t fragCount,
-                       const uint8_t* payload, size_t payloadSize)
+Slicer::encodeHeader(Encoder& encoder,
+                     uint64_t seq, uint16_t fragIndex, uint16_t fragCount,
+                     uint64_t congestionMark, size_t payloadSize)
 {
-  size_t totalLength = 0;
+  // the payload itself is not prepended, but counts in the length of NdnlpData
+  size_t totalLength = payloadSize;
 
   // NdnlpPayload
-  size_t payloadLength = blk.prependByteArray(payload, payloadSize);
-  totalLength += payloadLength;
-  totalLength += blk.prependVarNumber(payloadLength);
-  totalLength += blk.prependVarNumber(tlv::NdnlpPayload);
+  totalLength += encoder.prependVarNumber(payloadSize);
+  totalLength += encoder.prependVarNumber(tlv::NdnlpPayload);
+
+  if (congestionMark > 0) {
+    // NdnlpCongestionMark
+    size_t congestionMarkLength = encoder.prependNonNegativeInteger(congestionMark);
+    totalLength += congestionMarkLength;
+    totalLength += encoder.prependVarNumber(congestionMarkLength);
+    totalLength += encoder.prependVarNumber(tlv::NdnlpCongestionMark);
+  }
 
   bool needFragIndexAndCount = fragCount > 1;
   if (needFragIndexAndCount) {
     // NdnlpFragCount
-    size_t fragCountLength = blk.prependNonNegativeInteger(fragCount);
+    size_t fragCountLength = encoder.prependNonNegativeInteger(fragCount);
     totalLength += fragCountLength;
-    totalLength += blk.prependVarNumber(fragCountLength);
-    totalLength += blk.prependVarNumber(tlv::NdnlpFragCount);
+    totalLength += encoder.prependVarNumber(fragCountLength);
+    totalLength += encoder.prependVarNumber(tlv::NdnlpFragCount);
 
     // NdnlpFragIndex
-    size_t fragIndexLength = blk.prependNonNegativeInteger(fragIndex);
+    size_t fragIndexLength = encoder.prependNonNegativeInteger(fragIndex);
     totalLength += fragIndexLength;
-    totalLength += blk.prependVarNumber(fragIndexLength);
-    totalLength += blk.prependVarNumber(tlv::NdnlpFragIndex);
+    totalLength += encoder.prependVarNumber(fragIndexLength);
+    totalLength += encoder.prependVarNumber(tlv::NdnlpFragIndex);
   }
 
   // NdnlpSequence
   uint64_t sequenceBE = htobe64(seq);
-  size_t sequenceLength = blk.prependByteArray(
+  size_t sequenceLength = encoder.prependByteArray(
     reinterpret_cast<uint8_t*>(&sequenceBE), sizeof(sequenceBE));
   totalLength += sequenceLength;
-  totalLength += blk.prependVarNumber(sequenceLength);
-  totalLength += blk.prependVarNumber(tlv::NdnlpSequence);
+  totalLength += encoder.prependVarNumber(sequenceLength);
+  totalLength += encoder.prependVarNumber(tlv::NdnlpSequence);
 
   // NdnlpData
-  totalLength += blk.prependVarNumber(totalLength);
-  totalLength += blk.prependVarNumber(tlv::NdnlpData);
+  totalLength += encoder.prependVarNumber(totalLength);
+  totalLength += encoder.prependVarNumber(tlv::NdnlpData);
 
-  return totalLength;
+  return totalLength - payloadSize;
 }
 
 void
 Slicer::estimateOverhead()
 {
-  // estimate fragment size with all header fields at largest possible size
+  // estimate header size with all header fields at largest possible size
   ndn::EncodingEstimator estimator;
-  size_t estimatedSize = this->encodeFragment(estimator,
-                                              std::numeric_limits<uint64_t>::max(),
-                                              std::numeric_limits<uint16_t>::max() - 1,
-                                              std::numeric_limits<uint16_t>::max(),
-                                              nullptr, m_mtu);
+  size_t overhead = this->encodeHeader(estimator,
+                                       std::numeric_limits<uint64_t>::max(),
+                                       std::numeric_limits<uint16_t>::max() - 1,
+                                       std::numeric_limits<uint16_t>::max(),
+                                       std::numeric_limits<uint64_t>::max(),
+                                       m_mtu);
 
-  size_t overhead = estimatedSize - m_mtu; // minus payload length in estimation
+  BOOST_ASSERT(overhead <= Fragment::MAX_HEADER_SIZE);
   m_maxPayload = m_mtu - overhead;
 }
 
 PacketArray
-Slicer::slice(const Block& block)
+Slicer::slice(const Block& block, uint64_t congestionMark)
 {
   BOOST_ASSERT(block.hasWire());
   const uint8_t* networkPacket = block.wire();
@@ -120,8 +208,10 @@ Slicer::slice(const Block& block)
     size_t payloadSize = std::min(m_maxPayload, networkPacketSize - payloadOffset);
 
     ndn::EncodingBuffer buffer(m_mtu, 0);
-    size_t pktSize = this->encodeFragment(buffer,
-      seqBlock[fragIndex], fragIndex, fragCount, payload, payloadSize);
+    size_t pktSize = buffer.prependByteArray(payload, payloadSize);
+    pktSize += this->encodeHeader(buffer,
+      seqBlock[fragIndex], fragIndex, fragCount, fragIndex == 0 ? congestionMark : 0,
+      payloadSize);
 
     BOOST_VERIFY(pktSize <= m_mtu);
 
@@ -131,5 +221,48 @@ Slicer::slice(const Block& block)
   return pa;
 }
 
+void
+Slicer::slice(const Block& block, FragmentArray& fragments, uint64_t congestionMark)
+{
+  BOOST_ASSERT(block.hasWire());
+  const uint8_t* networkPacket = block.wire();
+  size_t networkPacketSize = block.size();
+
+  // fast path: the whole packet is the payload of one fragment
+  if (networkPacketSize <= m_maxPayload) {
+    fragments.resize(1);
+    Fragment& fragment = fragments.front();
+    HeaderEncoder encoder(fragment.m_header, Fragment::MAX_HEADER_SIZE);
+    this->encodeHeader(encoder, m_seqgen.nextBlock(1)[0], 0, 1, congestionMark,
+                       networkPacketSize);
+    fragment.m_headerOffset = encoder.getOffset();
+    fragment.m_payload = networkPacket;
+    fragment.m_payloadSize = networkPacketSize;
+    return;
+  }
+
+  uint16_t fragCount = static_cast<uint16_t>(
+                         (networkPacketSize / m_maxPayload) +
+                         (networkPacketSize % m_maxPayload == 0 ? 0 : 1)
+                       );
+  fragments.resize(fragCount);
+  SequenceBlock seqBlock = m_seqgen.nextBlock(fragCount);
+
+  for (uint16_t fragIndex = 0; fragIndex < fragCount; ++fragIndex) {
+    size_t payloadOffset = fragIndex * m_maxPayload;
+    Fragment& fragment = fragments[fragIndex];
+    fragment.m_payload = networkPacket + payloadOffset;
+    fragment.m_payloadSize = std::min(m_maxPayload, networkPacketSize - payloadOffset);
+
+    HeaderEncoder encoder(fragment.m_header, Fragment::MAX_HEADER_SIZE);
+    this->encodeHeader(encoder,
+      seqBlock[fragIndex], fragIndex, fragCount, fragIndex == 0 ? congestionMark : 0,
+      fragment.m_payloadSize);
+    fragment.m_headerOffset = encoder.getOffset();
+
+    BOOST_VERIFY(fragment.size() <= m_mtu);
+  }
+}
+
 } // namespace ndnlp
 } // namespace nfd
@@ -34,6 +34,45 @@ namespace ndnlp {
 
 typedef shared_ptr<std::vector<Block>> PacketArray;
 
+/** \brief an NDNLP packet whose payload refers to the network layer packet
+ *
+ *  Only the NDNLP header is encoded in the fragment. The payload is a range of
+ *  the sliced Block, which must stay alive and unmodified while it is in use.
+ */
+class Fragment
+{
+public:
+  /// max size of NDNLP header, up to and including TLV-LENGTH of NdnlpPayload
+  static const size_t MAX_HEADER_SIZE = 48;
+
+  const uint8_t*
+  getHeader() const;
+
+  size_t
+  getHeaderSize() const;
+
+  const uint8_t*
+  getPayload() const;
+
+  size_t
+  getPayloadSize() const;
+
+  /** \return{ size of the NDNLP packet }
+   */
+  size_t
+  size() const;
+
+private:
+  uint8_t m_header[MAX_HEADER_SIZE];
+  size_t m_headerOffset;
+  const uint8_t* m_payload;
+  size_t m_payloadSize;
+
+  friend class Slicer;
+};
+
+typedef std::vector<Fragment> FragmentArray;
+
 /** \brief provides fragmentation feature at sender
  */
 class Slicer : noncopyable
@@ -49,15 +88,32 @@ public:
   virtual
   ~Slicer();
 
+  /** \brief fragment a network layer packet
+   *  \param congestionMark if non-zero, carried in the first fragment
+   */
   PacketArray
-  slice(const Block& block);
+  slice(const Block& block, uint64_t congestionMark = 0);
+
+  /** \brief fragment a network layer packet without copying it
+   *
+   *  Only NDNLP headers are encoded; the payloads refer to \p block.
+   *  A packet that fits in one fragment is not divided at all: its single
+   *  fragment carries neither FragIndex nor FragCount.
+   *  \param[out] fragments replaced by the fragments, reusing its capacity
+   *  \param congestionMark if non-zero, carried in the first fragment
+   */
+  void
+  slice(const Block& block, FragmentArray& fragments, uint64_t congestionMark = 0);
 
 private:
-  template<bool T>
+  /** \brief prepend NDNLP header fields, up to and including TLV-LENGTH of NdnlpPayload
+   *  \return{ size of the header }
+   */
+  template<class Encoder>
   size_t
-  encodeFragment(ndn::EncodingImpl<T>& blk,
-                 uint64_t seq, uint16_t fragIndex, uint16_t fragCount,
-                 const uint8_t* payload, size_t payloadSize);
+  encodeHeader(Encoder& encoder,
+               uint64_t seq, uint16_t fragIndex, uint16_t fragCount,
+               uint64_t congestionMark, size_t payloadSize);
 
   /// estimate the size of NDNLP header and maximum payload size per packet
   void
@@ -73,6 +129,36 @@ private:
   size_t m_maxPayload;
 };
 
+inline const uint8_t*
+Fragment::getHeader() const
+{
+  return m_header + m_headerOffset;
+}
+
+inline size_t
+Fragment::getHeaderSize() const
+{
+  return MAX_HEADER_SIZE - m_headerOffset;
+}
+
+inline const uint8_t*
+Fragment::getPayload() const
+{
+  return m_payload;
+}
+
+inline size_t
+Fragment::getPayloadSize() const
+{
+  return m_payloadSize;
+}
+
+inline size_t
+Fragment::size() const
+{
+  return this->getHeaderSize() + m_payloadSize;
+}
+
 } // namespace ndnlp
 } // namespace nfd
 
@@ -34,7 +34,8 @@ enum
   NdnlpSequence  = 81,
   NdnlpFragIndex = 82,
   NdnlpFragCount = 83,
-  NdnlpPayload   = 84
+  NdnlpPayload   = 84,
+  NdnlpCongestionMark = 85
 };
 
 } // namespace tlv
@@ -28,6 +28,7 @@
 
 #include "face.hpp"
 #include "local-face.hpp"
+#include "input-buffer-pool.hpp"
 #include "core/global-io.hpp"
 
 namespace nfd {
@@ -54,10 +55,18 @@ public:
   void
   close() DECL_OVERRIDE;
 
+  size_t
+  getSendQueueLength() const DECL_OVERRIDE;
+
 protected:
   void
   processErrorCode(const boost::system::error_code& error);
 
+  /** \brief write queued blocks to the socket
+   *
+   *  All blocks at the front of the send queue, up to MAX_GATHERED_WRITE_SIZE bytes
+   *  (but at least one block), are submitted as one scatter-gather write.
+   */
   void
   sendFromQueue();
 
@@ -65,9 +74,16 @@ protected:
   handleSend(const boost::system::error_code& error,
              size_t nBytesSent);
 
+  /** \brief read from the socket once it is readable
+   *
+   *  A buffer is leased from the input buffer pool only for the duration of the read.
+   *  An incomplete trailing packet is kept in m_partialPacket until more bytes arrive.
+   */
+  void
+  handleReceive(const boost::system::error_code& error);
+
   void
-  handleReceive(const boost::system::error_code& error,
-                size_t nBytesReceived);
+  asyncWaitReadable();
 
   void
   shutdownSocket();
@@ -81,9 +97,13 @@ protected:
   NFD_LOG_INCLASS_DECLARE();
 
 private:
-  uint8_t m_inputBuffer[ndn::MAX_NDN_PACKET_SIZE];
-  size_t m_inputBufferSize;
-  std::queue<Block> m_sendQueue;
+  /// max total size of blocks submitted in one write operation
+  static const size_t MAX_GATHERED_WRITE_SIZE = 65536;
+
+  std::vector<uint8_t> m_partialPacket; ///< bytes of an incomplete packet
+  std::deque<Block> m_sendQueue;
+  size_t m_sendQueueLength; ///< total bytes in m_sendQueue
+  size_t m_nBlocksInFlight; ///< number of blocks at the front of m_sendQueue being written
 
   friend struct StreamFaceSenderImpl<Protocol, FaceBase, Interest>;
   friend struct StreamFaceSenderImpl<Protocol, FaceBase, Data>;
@@ -116,17 +136,17 @@ StreamFace<T, FaceBase>::StreamFace(const FaceUri& remoteUri, const FaceUri& loc
                                     typename StreamFace::protocol::socket socket, bool isOnDemand)
   : FaceBase(remoteUri, localUri)
   , m_socket(std::move(socket))
-  , m_inputBufferSize(0)
+  , m_sendQueueLength(0)
+  , m_nBlocksInFlight(0)
 {
   NFD_LOG_FACE_INFO("Creating face");
 
   this->setPersistency(isOnDemand ? ndn::nfd::FACE_PERSISTENCY_ON_DEMAND : ndn::nfd::FACE_PERSISTENCY_PERSISTENT);
   StreamFaceValidator<T, FaceBase>::validateSocket(m_socket);
 
-  m_socket.async_receive(boost::asio::buffer(m_inputBuffer, ndn::MAX_NDN_PACKET_SIZE),
-                         bind(&StreamFace<T, FaceBase>::handleReceive, this,
-                              boost::asio::placeholders::error,
-                              boost::asio::placeholders::bytes_transferred));
+  // reads are issued only after the socket is reported readable, and must not block
+  m_socket.non_blocking(true);
+  asyncWaitReadable();
 }
 
 
@@ -137,7 +157,8 @@ struct StreamFaceSenderImpl
   send(StreamFace<Protocol, FaceBase>& face, const Packet& packet)
   {
     bool wasQueueEmpty = face.m_sendQueue.empty();
-    face.m_sendQueue.push(packet.wireEncode());
+    face.m_sendQueue.push_back(packet.wireEncode());
+    face.m_sendQueueLength += face.m_sendQueue.back().size();
 
     if (wasQueueEmpty)
       face.sendFromQueue();
@@ -155,9 +176,11 @@ struct StreamFaceSenderImpl<Protocol, LocalFace, Packet>
 
     if (!face.isEmptyFilteredLocalControlHeader(packet.getLocalControlHeader()))
       {
-        face.m_sendQueue.push(face.filterAndEncodeLocalControlHeader(packet));
+        face.m_sendQueue.push_back(face.filterAndEncodeLocalControlHeader(packet));
+        face.m_sendQueueLength += face.m_sendQueue.back().size();
       }
-    face.m_sendQueue.push(packet.wireEncode());
+    face.m_sendQueue.push_back(packet.wireEncode());
+    face.m_sendQueueLength += face.m_sendQueue.back().size();
 
     if (wasQueueEmpty)
       face.sendFromQueue();
@@ -196,6 +219,13 @@ StreamFace<T, U>::close()
   this->fail("Face closed");
 }
 
+template<class T, class U>
+inline size_t
+StreamFace<T, U>::getSendQueueLength() const
+{
+  return m_sendQueueLength;
+}
+
 template<class T, class U>
 inline void
 StreamFace<T, U>::processErrorCode(const boost::system::error_code& error)
@@ -225,7 +255,21 @@ template<class T, class U>
 inline void
 StreamFace<T, U>::sendFromQueue()
 {
-  boost::asio::async_write(m_socket, boost::asio::buffer(m_sendQueue.front()),
+  BOOST_ASSERT(m_nBlocksInFlight == 0);
+
+  // blocks queued while a write is in progress are sent together in the next write
+  std::vector<boost::asio::const_buffer> buffers;
+  size_t nBytes = 0;
+  for (const Block& block : m_sendQueue) {
+    if (!buffers.empty() && nBytes + block.size() > MAX_GATHERED_WRITE_SIZE)
+      break;
+
+    buffers.push_back(boost::asio::buffer(block.wire(), block.size()));
+    nBytes += block.size();
+  }
+  m_nBlocksInFlight = buffers.size();
+
+  boost::asio::async_write(m_socket, buffers,
                            bind(&StreamFace<T, U>::handleSend, this,
                                 boost::asio::placeholders::error,
                                 boost::asio::placeholders::bytes_transferred));
@@ -239,49 +283,84 @@ StreamFace<T, U>::handleSend(const boost::system::error_code& error,
   if (error)
     return processErrorCode(error);
 
-  BOOST_ASSERT(!m_sendQueue.empty());
+  BOOST_ASSERT(m_sendQueue.size() >= m_nBlocksInFlight);
 
-  NFD_LOG_FACE_TRACE("Successfully sent: " << nBytesSent << " bytes");
+  NFD_LOG_FACE_TRACE("Successfully sent: " << nBytesSent << " bytes in "
+                     << m_nBlocksInFlight << " block(s)");
   this->getMutableCounters().getNOutBytes() += nBytesSent;
 
-  m_sendQueue.pop();
+  // async_write completes only after all submitted bytes are written
+  for (; m_nBlocksInFlight > 0; --m_nBlocksInFlight) {
+    m_sendQueueLength -= m_sendQueue.front().size();
+    m_sendQueue.pop_front();
+  }
   if (!m_sendQueue.empty())
     sendFromQueue();
+
+  this->emitSignal(onTransmitComplete);
+}
+
+template<class T, class U>
+inline void
+StreamFace<T, U>::asyncWaitReadable()
+{
+  m_socket.async_receive(boost::asio::null_buffers(),
+                         bind(&StreamFace<T, U>::handleReceive, this,
+                              boost::asio::placeholders::error));
 }
 
 template<class T, class U>
 inline void
-StreamFace<T, U>::handleReceive(const boost::system::error_code& error,
-                                size_t nBytesReceived)
+StreamFace<T, U>::handleReceive(const boost::system::error_code& error)
 {
   if (error)
     return processErrorCode(error);
 
+  InputBufferPool::Lease buffer(getGlobalInputBufferPool());
+  uint8_t* inputBuffer = buffer.get();
+  size_t inputBufferSize = m_partialPacket.size();
+  std::copy(m_partialPacket.begin(), m_partialPacket.end(), inputBuffer);
+
+  boost::system::error_code readError;
+  size_t nBytesReceived = m_socket.receive(boost::asio::buffer(inputBuffer + inputBufferSize,
+                                                               InputBufferPool::BUFFER_SIZE -
+                                                               inputBufferSize),
+                                           0, readError);
+  if (readError == boost::asio::error::would_block)
+    return asyncWaitReadable();
+  if (readError)
+    return processErrorCode(readError);
+
   NFD_LOG_FACE_TRACE("Received: " << nBytesReceived << " bytes");
   this->getMutableCounters().getNInBytes() += nBytesReceived;
 
-  m_inputBufferSize += nBytesReceived;
+  inputBufferSize += nBytesReceived;
 
   size_t offset = 0;
 
   bool isOk = true;
   Block element;
-  while (m_inputBufferSize - offset > 0) {
-    std::tie(isOk, element) = Block::fromBuffer(m_inputBuffer + offset, m_inputBufferSize - offset);
+  std::vector<Block> elements;
+  while (inputBufferSize - offset > 0) {
+    std::tie(isOk, element) = Block::fromBuffer(inputBuffer + offset, inputBufferSize - offset);
     if (!isOk)
       break;
 
     offset += element.size();
 
-    BOOST_ASSERT(offset <= m_inputBufferSize);
+    BOOST_ASSERT(offset <= inputBufferSize);
 
-    if (!this->decodeAndDispatchInput(element)) {
-      NFD_LOG_FACE_WARN("Received unrecognized TLV block of type " << element.type());
-      // ignore unknown packet and proceed
-    }
+    elements.push_back(element);
+  }
+
+  // all packets of this read are forwarded as one batch
+  size_t nUnrecognized = this->decodeAndDispatchInput(elements);
+  if (nUnrecognized > 0) {
+    NFD_LOG_FACE_WARN("Received " << nUnrecognized << " unrecognized TLV block(s)");
+    // ignore unknown packets and proceed
   }
 
-  if (!isOk && m_inputBufferSize == ndn::MAX_NDN_PACKET_SIZE && offset == 0)
+  if (!isOk && inputBufferSize == InputBufferPool::BUFFER_SIZE && offset == 0)
     {
       NFD_LOG_FACE_WARN("Failed to parse incoming packet or packet too large to process");
       shutdownSocket();
@@ -289,25 +368,10 @@ StreamFace<T, U>::handleReceive(const boost::system::error_code& error,
       return;
     }
 
-  if (offset > 0)
-    {
-      if (offset != m_inputBufferSize)
-        {
-          std::copy(m_inputBuffer + offset, m_inputBuffer + m_inputBufferSize,
-                    m_inputBuffer);
-          m_inputBufferSize -= offset;
-        }
-      else
-        {
-          m_inputBufferSize = 0;
-        }
-    }
+  // keep only the incomplete packet, in a right-sized allocation
+  std::vector<uint8_t>(inputBuffer + offset, inputBuffer + inputBufferSize).swap(m_partialPacket);
 
-  m_socket.async_receive(boost::asio::buffer(m_inputBuffer + m_inputBufferSize,
-                                             ndn::MAX_NDN_PACKET_SIZE - m_inputBufferSize),
-                         bind(&StreamFace<T, U>::handleReceive, this,
-                              boost::asio::placeholders::error,
-                              boost::asio::placeholders::bytes_transferred));
+  asyncWaitReadable();
 }
 
 template<class T, class U>
@@ -348,8 +412,10 @@ StreamFace<T, U>::deferredClose(const shared_ptr<Face>& face)
   NFD_LOG_FACE_TRACE(__func__);
 
   // clear send queue
-  std::queue<Block> emptyQueue;
+  std::deque<Block> emptyQueue;
   std::swap(emptyQueue, m_sendQueue);
+  m_sendQueueLength = 0;
+  m_nBlocksInFlight = 0;
 
   // use the non-throwing variant and ignore errors, if any
   boost::system::error_code error;
@@ -36,8 +36,6 @@ NFD_REGISTER_STRATEGY(AccessStrategy);
 
 AccessStrategy::AccessStrategy(Forwarder& forwarder, const Name& name)
   : Strategy(forwarder, name)
-  , m_removeFaceInfoConn(this->beforeRemoveFace.connect(
-                         bind(&AccessStrategy::removeFaceInfo, this, _1)))
 {
 }
 
@@ -217,13 +215,13 @@ void
 AccessStrategy::updateMeasurements(const Face& inFace, const Data& data,
                                    const RttEstimator::Duration& rtt)
 {
-  FaceInfo& fi = m_fit[inFace.getId()];
-  fi.rtt.addMeasurement(rtt);
+  // per-face RTT has already been updated by the forwarder
+  const RttEstimator& faceRtt = this->getLinkEstimator().get(inFace.getId()).getRttEstimator();
 
   shared_ptr<MtInfo> mi = this->addPrefixMeasurements(data);
   if (mi->lastNexthop != inFace.getId()) {
     mi->lastNexthop = inFace.getId();
-    mi->rtt = fi.rtt;
+    mi->rtt = faceRtt;
   }
   else {
     mi->rtt.addMeasurement(rtt);
@@ -270,16 +268,5 @@ AccessStrategy::addPrefixMeasurements(const Data& data)
   return me->getOrCreateStrategyInfo<MtInfo>();
 }
 
-AccessStrategy::FaceInfo::FaceInfo()
-  : rtt(1, time::milliseconds(1), 0.1)
-{
-}
-
-void
-AccessStrategy::removeFaceInfo(shared_ptr<Face> face)
-{
-  m_fit.erase(face->getId());
-}
-
 } // namespace fw
 } // namespace nfd
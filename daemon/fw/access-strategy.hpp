@@ -30,7 +30,6 @@
 #include "rtt-estimator.hpp"
 #include "retx-suppression-fixed.hpp"
 #include <unordered_set>
-#include <unordered_map>
 
 namespace nfd {
 namespace fw {
@@ -110,22 +109,6 @@ private: // StrategyInfo
   shared_ptr<MtInfo>
   addPrefixMeasurements(const Data& data);
 
-  /** \brief global per-face StrategyInfo
-   */
-  class FaceInfo
-  {
-  public:
-    FaceInfo();
-
-  public:
-    RttEstimator rtt;
-  };
-
-  typedef std::unordered_map<FaceId, FaceInfo> FaceInfoTable;
-
-  void
-  removeFaceInfo(shared_ptr<Face> face);
-
 private: // forwarding procedures
   void
   afterReceiveNewInterest(const Face& inFace,
@@ -166,9 +149,7 @@ public:
   static const Name STRATEGY_NAME;
 
 private:
-  FaceInfoTable m_fit;
   RetxSuppressionFixed m_retxSuppression;
-  signal::ScopedConnection m_removeFaceInfoConn;
 };
 
 } // namespace fw
@@ -18,8 +18,6 @@
  * Author: Klaus Schneider <klaus.schneider@uni-bamberg.de>
  */
 #include "broadcast-newnonce-strategy.hpp"
-#include "strategy-helper.hpp"
-#include <map>
 #include "core/logger.hpp"
 
 namespace nfd {
@@ -44,19 +42,9 @@ void BroadcastNewNonceStrategy::afterReceiveInterest(const Face& inFace, const I
     shared_ptr<fib::Entry> fibEntry, shared_ptr<pit::Entry> pitEntry)
 {
 
-  bool useNonce = true;
-  // Getting nonce value from parameters;
-  std::string parameterString = ownStrategyChoice.findEffectiveParameters(
-      interest.getName().toUri());
-  std::map < std::string, std::string > parameterMap = StrategyHelper::getParameterMap(
-      parameterString);
-
-  std::map<std::string, std::string>::const_iterator it = parameterMap.find("nonce");
-  if (it != parameterMap.end()) {
-    if (it->second == "false") {
-      useNonce = false;
-    }
-  }
+  // Getting nonce value from parameters (parsed once per strategy choice entry)
+  const StrategyParameters& parameters = ownStrategyChoice.findEffectiveParameters(*pitEntry);
+  bool useNonce = parameters.get("nonce") != "false";
 
   const fib::NextHopList& nexthops = fibEntry->getNextHops();
 
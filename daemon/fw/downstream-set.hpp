@@ -0,0 +1,128 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2014-2015,  Regents of the University of California,
+ *                           Arizona Board of Regents,
+ *                           Colorado State University,
+ *                           University Pierre & Marie Curie, Sorbonne University,
+ *                           Washington University in St. Louis,
+ *                           Beijing Institute of Technology,
+ *                           The University of Memphis.
+ *
+ * This file is part of NFD (Named Data Networking Forwarding Daemon).
+ * See AUTHORS.md for complete list of NFD authors and contributors.
+ *
+ * NFD is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * NFD is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * NFD, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+#ifndef NFD_DAEMON_FW_DOWNSTREAM_SET_HPP
+#define NFD_DAEMON_FW_DOWNSTREAM_SET_HPP
+
+#include "face/face.hpp"
+
+#include <bitset>
+
+namespace nfd {
+namespace fw {
+
+/** \brief a set of downstream faces that a Data is forwarded to
+ *
+ *  Faces are kept in insertion order. Most Data have few downstreams, so the set keeps
+ *  up to N_INLINE faces in a flat array, and remembers FaceIds below N_FACEID_BITS in a
+ *  bitset; it needs no heap allocation unless either limit is exceeded.
+ */
+class DownstreamSet : noncopyable
+{
+public:
+  DownstreamSet()
+    : m_nInline(0)
+  {
+  }
+
+  /** \brief insert face unless it is already in the set
+   *  \return whether face has been inserted
+   */
+  bool
+  insert(const shared_ptr<Face>& face)
+  {
+    FaceId id = face->getId();
+    if (id >= 0 && static_cast<size_t>(id) < N_FACEID_BITS) {
+      if (m_seen.test(id)) {
+        return false;
+      }
+      m_seen.set(id);
+    }
+    else if (this->contains(*face)) {
+      return false;
+    }
+
+    if (m_nInline < N_INLINE) {
+      m_inline[m_nInline++] = face;
+    }
+    else {
+      m_spill.push_back(face);
+    }
+    return true;
+  }
+
+  size_t
+  size() const
+  {
+    return m_nInline + m_spill.size();
+  }
+
+  /** \brief invoke f(face) on each face, in insertion order
+   */
+  template<typename F>
+  void
+  forEach(const F& f) const
+  {
+    for (size_t i = 0; i < m_nInline; ++i) {
+      f(m_inline[i]);
+    }
+    for (const shared_ptr<Face>& face : m_spill) {
+      f(face);
+    }
+  }
+
+private:
+  bool
+  contains(const Face& face) const
+  {
+    for (size_t i = 0; i < m_nInline; ++i) {
+      if (m_inline[i].get() == &face) {
+        return true;
+      }
+    }
+    for (const shared_ptr<Face>& other : m_spill) {
+      if (other.get() == &face) {
+        return true;
+      }
+    }
+    return false;
+  }
+
+public:
+  static const size_t N_INLINE = 8;
+  static const size_t N_FACEID_BITS = 1024;
+
+private:
+  std::bitset<N_FACEID_BITS> m_seen;
+  shared_ptr<Face> m_inline[N_INLINE];
+  size_t m_nInline;
+  std::vector<shared_ptr<Face>> m_spill;
+};
+
+} // namespace fw
+} // namespace nfd
+
+#endif // NFD_DAEMON_FW_DOWNSTREAM_SET_HPP
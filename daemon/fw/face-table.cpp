@@ -27,13 +27,16 @@
 #include "forwarder.hpp"
 #include "core/logger.hpp"
 
+#include <limits>
+
 namespace nfd {
 
 NFD_LOG_INIT("FaceTable");
 
 FaceTable::FaceTable(Forwarder& forwarder)
   : m_forwarder(forwarder)
-  , m_lastFaceId(FACEID_RESERVED_MAX)
+  , m_faces(FACEID_RESERVED_MAX + 1)
+  , m_nFaces(0)
 {
 }
 
@@ -45,26 +48,44 @@ FaceTable::~FaceTable()
 shared_ptr<Face>
 FaceTable::get(FaceId id) const
 {
-  std::map<FaceId, shared_ptr<Face> >::const_iterator i = m_faces.find(id);
-  return (i == m_faces.end()) ? (shared_ptr<Face>()) : (i->second);
+  size_t slot = id & SLOT_MASK;
+  if (id < 0 || slot >= m_faces.size()) {
+    return nullptr;
+  }
+
+  const shared_ptr<Face>& face = m_faces[slot];
+  if (face == nullptr || face->getId() != id) { // empty slot, or reused by a newer face
+    return nullptr;
+  }
+  return face;
 }
 
 size_t
 FaceTable::size() const
 {
-  return m_faces.size();
+  return m_nFaces;
 }
 
 void
 FaceTable::add(shared_ptr<Face> face)
 {
-  if (face->getId() != INVALID_FACEID && m_faces.count(face->getId()) > 0) {
+  if (face->getId() != INVALID_FACEID && this->get(face->getId()) != nullptr) {
     NFD_LOG_WARN("Trying to add existing face id=" << face->getId() << " to the face table");
     return;
   }
 
-  FaceId faceId = ++m_lastFaceId;
-  BOOST_ASSERT(faceId > FACEID_RESERVED_MAX);
+  FaceId faceId;
+  if (m_freeIds.empty()) {
+    BOOST_ASSERT(m_faces.size() <= static_cast<size_t>(SLOT_MASK));
+    faceId = static_cast<FaceId>(m_faces.size());
+  }
+  else {
+    // next generation of the slot; the generation wraps around within the sign bit
+    FaceId lastId = m_freeIds.back();
+    m_freeIds.pop_back();
+    faceId = (lastId + (1 << SLOT_BITS)) & std::numeric_limits<FaceId>::max();
+  }
+  BOOST_ASSERT((faceId & SLOT_MASK) > FACEID_RESERVED_MAX);
   this->addImpl(face, faceId);
 }
 
@@ -72,8 +93,8 @@ void
 FaceTable::addReserved(shared_ptr<Face> face, FaceId faceId)
 {
   BOOST_ASSERT(face->getId() == INVALID_FACEID);
-  BOOST_ASSERT(m_faces.count(face->getId()) == 0);
   BOOST_ASSERT(faceId <= FACEID_RESERVED_MAX);
+  BOOST_ASSERT(this->get(faceId) == nullptr);
   this->addImpl(face, faceId);
 }
 
@@ -81,12 +102,19 @@ void
 FaceTable::addImpl(shared_ptr<Face> face, FaceId faceId)
 {
   face->setId(faceId);
-  m_faces[faceId] = face;
+  size_t slot = faceId & SLOT_MASK;
+  if (slot >= m_faces.size()) {
+    m_faces.resize(slot + 1);
+  }
+  m_faces[slot] = face;
+  ++m_nFaces;
   NFD_LOG_INFO("Added face id=" << faceId << " remote=" << face->getRemoteUri()
                                           << " local=" << face->getLocalUri());
 
   face->onReceiveInterest.connect(bind(&Forwarder::onInterest, &m_forwarder, ref(*face), _1));
   face->onReceiveData.connect(bind(&Forwarder::onData, &m_forwarder, ref(*face), _1));
+  face->beforeReceiveBatch.connect(bind(&Forwarder::onReceiveBatch, &m_forwarder, _1));
+  face->setReceiveFilter(bind(&Forwarder::filterIncomingPacket, &m_forwarder, cref(*face), _1));
   face->onFail.connectSingleShot(bind(&FaceTable::remove, this, face, _1));
 
   this->onAdd(face);
@@ -98,7 +126,11 @@ FaceTable::remove(shared_ptr<Face> face, const std::string& reason)
   this->onRemove(face);
 
   FaceId faceId = face->getId();
-  m_faces.erase(faceId);
+  m_faces[faceId & SLOT_MASK].reset();
+  --m_nFaces;
+  if ((faceId & SLOT_MASK) > FACEID_RESERVED_MAX) {
+    m_freeIds.push_back(faceId);
+  }
   face->setId(INVALID_FACEID);
 
   NFD_LOG_INFO("Removed face id=" << faceId <<
@@ -107,12 +139,13 @@ FaceTable::remove(shared_ptr<Face> face, const std::string& reason)
                " (" << reason << ")");
 
   m_forwarder.getFib().removeNextHopFromAllEntries(face);
+  m_forwarder.getPit().deleteFaceRecords(*face);
 }
 
 FaceTable::ForwardRange
 FaceTable::getForwardRange() const
 {
-  return m_faces | boost::adaptors::map_values;
+  return m_faces | boost::adaptors::filtered(IsOccupied());
 }
 
 FaceTable::const_iterator
@@ -27,13 +27,20 @@
 #define NFD_DAEMON_FW_FACE_TABLE_HPP
 
 #include "face/face.hpp"
-#include <boost/range/adaptor/map.hpp>
+#include <boost/range/adaptor/filtered.hpp>
 
 namespace nfd {
 
 class Forwarder;
 
 /** \brief container of all Faces
+ *
+ *  Faces are stored in a vector of slots, so that get() is a bounds check and an array
+ *  access. The low SLOT_BITS of a FaceId select the slot, and the remaining bits hold the
+ *  generation of that slot. Slots of removed faces are reused, with the generation
+ *  incremented, so the vector does not grow beyond the largest number of faces that existed
+ *  at once, and a stale FaceId does not find the face that reuses its slot.
+ *  Reserved FaceIds are generation 0 of slots 0 to FACEID_RESERVED_MAX.
  */
 class FaceTable : noncopyable
 {
@@ -58,9 +65,20 @@ public:
   size() const;
 
 public: // enumeration
-  typedef std::map<FaceId, shared_ptr<Face>> FaceMap;
+  typedef std::vector<shared_ptr<Face>> FaceSlots;
+
+  /** \brief selects occupied slots
+   */
+  struct IsOccupied
+  {
+    bool
+    operator()(const shared_ptr<Face>& face) const
+    {
+      return face != nullptr;
+    }
+  };
 
-  typedef boost::select_second_const_range<FaceMap> ForwardRange;
+  typedef boost::filtered_range<IsOccupied, const FaceSlots> ForwardRange;
 
   /** \brief ForwardIterator for shared_ptr<Face>
    */
@@ -83,6 +101,11 @@ public: // signals
    */
   signal::Signal<FaceTable, shared_ptr<Face>> onRemove;
 
+PUBLIC_WITH_TESTS_ELSE_PRIVATE:
+  /// number of FaceId bits that select the slot
+  static const int SLOT_BITS = 20;
+  static const FaceId SLOT_MASK = (1 << SLOT_BITS) - 1;
+
 private:
   void
   addImpl(shared_ptr<Face> face, FaceId faceId);
@@ -97,8 +120,9 @@ private:
 
 private:
   Forwarder& m_forwarder;
-  FaceId m_lastFaceId;
-  FaceMap m_faces;
+  FaceSlots m_faces; ///< indexed by FaceId & SLOT_MASK
+  std::vector<FaceId> m_freeIds; ///< last FaceIds of empty non-reserved slots
+  size_t m_nFaces;
 };
 
 } // namespace nfd
@@ -27,12 +27,16 @@
 #include "core/logger.hpp"
 #include "core/random.hpp"
 #include "strategy.hpp"
+#include "downstream-set.hpp"
 #include "face/null-face.hpp"
+#include "face/congestion-mark-tag.hpp"
 
 #include "utils/ndn-ns3-packet-tag.hpp"
 
 #include <boost/random/uniform_int_distribution.hpp>
 
+#include <cstring> // for std::memcpy()
+
 namespace nfd {
 
 NFD_LOG_INIT("Forwarder");
@@ -51,6 +55,22 @@ Forwarder::Forwarder()
 {
   fw::installStrategies(*this);
   getFaceTable().addReserved(m_csFace, FACEID_CONTENT_STORE);
+
+  m_faceTable.onRemove.connect([this] (shared_ptr<Face> face) {
+    m_linkEstimator.erase(face->getId());
+    m_trafficManager.erase(face->getId());
+    m_interestShaper.erase(face->getId());
+  });
+
+  m_interestShaper.afterRelease.connect([this] (shared_ptr<pit::Entry> pitEntry,
+                                                shared_ptr<Face> outFace,
+                                                shared_ptr<Interest> interest) {
+    if (pitEntry->getInRecords().empty()) {
+      // satisfied or rejected while delayed
+      return;
+    }
+    this->sendInterest(pitEntry, *outFace, *interest);
+  });
 }
 
 Forwarder::~Forwarder()
@@ -58,6 +78,69 @@ Forwarder::~Forwarder()
 
 }
 
+void
+Forwarder::onReceiveBatch(const ReceiveBatch& batch)
+{
+  // hash values live on the stack, so the batch is prefetched in chunks of bounded size
+  static const size_t CHUNK_SIZE = 16;
+  size_t hashValues[CHUNK_SIZE][NameTree::MAX_PREFETCH_DEPTH];
+  size_t nHashValues[CHUNK_SIZE];
+
+  for (size_t begin = 0; begin < batch.size(); begin += CHUNK_SIZE) {
+    size_t chunkSize = std::min(CHUNK_SIZE, batch.size() - begin);
+    for (size_t i = 0; i < chunkSize; ++i) {
+      nHashValues[i] = m_nameTree.prefetchBuckets(batch[begin + i].name, hashValues[i]);
+    }
+    for (size_t i = 0; i < chunkSize; ++i) {
+      m_nameTree.prefetchNodes(hashValues[i], nHashValues[i]);
+    }
+  }
+}
+
+bool
+Forwarder::filterIncomingPacket(const Face& inFace, const ReceivedPacket& packet)
+{
+  bool isViolatingLocalhost = !inFace.isLocal() && LOCALHOST_NAME.isPrefixOf(packet.name);
+
+  if (packet.wire.type() == tlv::Interest) {
+    if (isViolatingLocalhost) {
+      NFD_LOG_DEBUG("filterIncomingPacket face=" << inFace.getId() <<
+                    " interest=" << packet.name << " violates /localhost");
+    }
+    // a duplicate Nonce in the PIT entry is found by the pipeline, because the PIT entry
+    // cannot be located without Selectors
+    else if (m_deadNonceList.has(packet.name, packet.nonce)) {
+      NFD_LOG_DEBUG("filterIncomingPacket face=" << inFace.getId() <<
+                    " interest=" << packet.name << " loops");
+    }
+    else {
+      return true;
+    }
+
+    ++m_counters.getNInInterests();
+    return false;
+  }
+
+  if (isViolatingLocalhost) {
+    NFD_LOG_DEBUG("filterIncomingPacket face=" << inFace.getId() <<
+                  " data=" << packet.name << " violates /localhost");
+  }
+  // Data is unsolicited if no prefix of its Name has a PIT entry;
+  // unsolicited Data from a local face is cached, so it must be decoded
+  else if (!inFace.isLocal() &&
+           m_nameTree.findLongestPrefixMatch(packet.name,
+             [] (const name_tree::Entry& entry) { return entry.hasPitEntries(); }) == nullptr) {
+    NFD_LOG_DEBUG("filterIncomingPacket face=" << inFace.getId() <<
+                  " data=" << packet.name << " unsolicited");
+  }
+  else {
+    return true;
+  }
+
+  ++m_counters.getNInDatas();
+  return false;
+}
+
 void
 Forwarder::onIncomingInterest(Face& inFace, const Interest& interest)
 {
@@ -197,6 +280,27 @@ compare_pickInterest(const pit::InRecord& a, const pit::InRecord& b, const Face*
   return a.getLastRenewed() > b.getLastRenewed();
 }
 
+shared_ptr<Interest>
+Forwarder::makeInterestWithNonce(const Interest& interest, uint32_t nonce)
+{
+  const Block& wire = interest.wireEncode();
+  wire.parse();
+  const Block& nonceBlock = wire.get(tlv::Nonce);
+  if (nonceBlock.value_size() != sizeof(nonce)) {
+    shared_ptr<Interest> copy = make_shared<Interest>(interest);
+    copy->setNonce(nonce);
+    return copy;
+  }
+
+  auto buffer = make_shared<ndn::Buffer>(wire.wire(), wire.size());
+  std::memcpy(buffer->buf() + (nonceBlock.value() - wire.wire()), &nonce, sizeof(nonce));
+
+  shared_ptr<Interest> copy = make_shared<Interest>(Block(buffer));
+  copy->getLocalControlHeader() = interest.getLocalControlHeader();
+  static_cast<ndn::TagHost&>(*copy) = interest;
+  return copy;
+}
+
 void
 Forwarder::onOutgoingInterest(shared_ptr<pit::Entry> pitEntry, Face& outFace,
                               bool wantNewNonce)
@@ -224,19 +328,53 @@ Forwarder::onOutgoingInterest(shared_ptr<pit::Entry> pitEntry, Face& outFace,
     pickedInRecord->getInterest().shared_from_this());
 
   if (wantNewNonce) {
-    interest = make_shared<Interest>(*interest);
     static boost::random::uniform_int_distribution<uint32_t> dist;
-    interest->setNonce(dist(getGlobalRng()));
+    interest = makeInterestWithNonce(*interest, dist(getGlobalRng()));
   }
 
+  // Interest shaping
+  switch (m_interestShaper.shape(pitEntry, outFace, interest)) {
+  case fw::InterestShaper::SEND:
+    break;
+  case fw::InterestShaper::DELAYED:
+    // the OutRecord is inserted by sendInterest when the Interest is released, so that
+    // an Interest that was never transmitted is not counted as lost by onInterestFinalize
+    return;
+  case fw::InterestShaper::REJECTED:
+    NFD_LOG_DEBUG("onOutgoingInterest face=" << outFace.getId() <<
+                  " interest=" << pitEntry->getName() << " return path overloaded");
+    // the strategy may still forward to other faces, so reject after it returns
+    scheduler::schedule(time::nanoseconds::zero(),
+                        bind(&Forwarder::onInterestShapedOut, this,
+                             weak_ptr<pit::Entry>(pitEntry)));
+    return;
+  }
+
+  this->sendInterest(pitEntry, outFace, *interest);
+}
+
+void
+Forwarder::sendInterest(shared_ptr<pit::Entry> pitEntry, Face& outFace, const Interest& interest)
+{
   // insert OutRecord
-  pitEntry->insertOrUpdateOutRecord(outFace.shared_from_this(), *interest);
+  pitEntry->insertOrUpdateOutRecord(outFace.shared_from_this(), interest);
 
   // send Interest
-  outFace.sendInterest(*interest);
+  outFace.sendInterest(interest);
   ++m_counters.getNOutInterests();
 }
 
+void
+Forwarder::onInterestShapedOut(weak_ptr<pit::Entry> weakPitEntry)
+{
+  shared_ptr<pit::Entry> pitEntry = weakPitEntry.lock();
+  if (pitEntry == nullptr || pitEntry->getInRecords().empty() ||
+      pitEntry->hasUnexpiredOutRecords() || m_interestShaper.hasDelayed(*pitEntry)) {
+    return;
+  }
+  this->onInterestReject(pitEntry);
+}
+
 void
 Forwarder::onInterestReject(shared_ptr<pit::Entry> pitEntry)
 {
@@ -278,6 +416,13 @@ Forwarder::onInterestFinalize(shared_ptr<pit::Entry> pitEntry, bool isSatisfied,
   // Dead Nonce List insert if necessary
   this->insertDeadNonceList(*pitEntry, isSatisfied, dataFreshnessPeriod, 0);
 
+  // remaining OutRecords were never answered: count as loss on those upstreams
+  for (const pit::OutRecord& outRecord : pitEntry->getOutRecords()) {
+    if (outRecord.getFace()->getId() != INVALID_FACEID) {
+      m_linkEstimator.afterLoseInterest(*outRecord.getFace());
+    }
+  }
+
   // PIT delete
   this->cancelUnsatisfyAndStragglerTimer(pitEntry);
   m_pit.erase(pitEntry);
@@ -309,22 +454,20 @@ Forwarder::onIncomingData(Face& inFace, const Data& data)
     return;
   }
 
-  // Remove Ptr<Packet> from the Data before inserting into cache, serving two purposes
-  // - reduce amount of memory used by cached entries
-  // - remove all tags that (e.g., hop count tag) that could have been associated with Ptr<Packet>
-  //
-  // Copying of Data is relatively cheap operation, as it copies (mostly) a collection of Blocks
-  // pointing to the same underlying memory buffer.
-  shared_ptr<Data> dataCopyWithoutPacket = make_shared<Data>(data);
-  dataCopyWithoutPacket->removeTag<ns3::ndn::Ns3PacketTag>();
+  // learn the Data size on inFace for Interest shaping
+  m_interestShaper.afterReceiveData(inFace, data);
 
   // CS insert
+  shared_ptr<const Data> cachedData = this->makeCacheableData(data);
   if (m_csFromNdnSim == nullptr)
-    m_cs.insert(*dataCopyWithoutPacket);
+    m_cs.insert(*cachedData);
   else
-    m_csFromNdnSim->Add(dataCopyWithoutPacket);
+    m_csFromNdnSim->Add(cachedData);
+
+  bool isCongestionMarked = getCongestionMark(data) > 0;
+  time::steady_clock::TimePoint now = time::steady_clock::now();
 
-  std::set<shared_ptr<Face> > pendingDownstreams;
+  fw::DownstreamSet pendingDownstreams;
   // foreach PitEntry
   for (const shared_ptr<pit::Entry>& pitEntry : pitMatches) {
     NFD_LOG_DEBUG("onIncomingData matching=" << pitEntry->getName());
@@ -334,13 +477,20 @@ Forwarder::onIncomingData(Face& inFace, const Data& data)
 
     // remember pending downstreams
     const pit::InRecordCollection& inRecords = pitEntry->getInRecords();
-    for (pit::InRecordCollection::const_iterator it = inRecords.begin();
-                                                 it != inRecords.end(); ++it) {
-      if (it->getExpiry() > time::steady_clock::now()) {
-        pendingDownstreams.insert(it->getFace());
+    for (const pit::InRecord& inRecord : inRecords) {
+      if (inRecord.getExpiry() > now && inRecord.getFace().get() != &inFace) {
+        pendingDownstreams.insert(inRecord.getFace());
       }
     }
 
+    // update link estimation of inFace, before strategies query it
+    pit::OutRecordCollection::const_iterator outRecord = pitEntry->getOutRecord(inFace);
+    if (outRecord != pitEntry->getOutRecords().end()) {
+      m_linkEstimator.afterSatisfyInterest(inFace, data.getContent().value_size(),
+                                           now - outRecord->getLastRenewed(),
+                                           isCongestionMarked);
+    }
+
     // invoke PIT satisfy callback
     beforeSatisfyInterest(*pitEntry, inFace, data);
     this->dispatchToStrategy(pitEntry, bind(&Strategy::beforeSatisfyInterest, _1,
@@ -357,16 +507,28 @@ Forwarder::onIncomingData(Face& inFace, const Data& data)
     this->setStragglerTimer(pitEntry, true, data.getFreshnessPeriod());
   }
 
-  // foreach pending downstream
-  for (std::set<shared_ptr<Face> >::iterator it = pendingDownstreams.begin();
-      it != pendingDownstreams.end(); ++it) {
-    shared_ptr<Face> pendingDownstream = *it;
-    if (pendingDownstream.get() == &inFace) {
-      continue;
-    }
+  // foreach pending downstream: each face gets the Data once, and the Data's wire encoding
+  // is shared by all of them
+  pendingDownstreams.forEach([this, &data] (const shared_ptr<Face>& pendingDownstream) {
     // goto outgoing Data pipeline
     this->onOutgoingData(data, *pendingDownstream);
+  });
+}
+
+shared_ptr<const Data>
+Forwarder::makeCacheableData(const Data& data)
+{
+  if (data.getTag<ns3::ndn::Ns3PacketTag>() == nullptr &&
+      data.getTag<CongestionMarkTag>() == nullptr) {
+    return data.shared_from_this();
   }
+
+  // Copying of Data is relatively cheap operation, as it copies (mostly) a collection of Blocks
+  // pointing to the same underlying memory buffer.
+  shared_ptr<Data> copy = make_shared<Data>(data);
+  copy->removeTag<ns3::ndn::Ns3PacketTag>();
+  copy->removeTag<CongestionMarkTag>();
+  return copy;
 }
 
 void
@@ -376,10 +538,11 @@ Forwarder::onDataUnsolicited(Face& inFace, const Data& data)
   bool acceptToCache = inFace.isLocal();
   if (acceptToCache) {
     // CS insert
+    shared_ptr<const Data> cachedData = this->makeCacheableData(data);
     if (m_csFromNdnSim == nullptr)
-      m_cs.insert(data, true);
+      m_cs.insert(*cachedData, true);
     else
-      m_csFromNdnSim->Add(data.shared_from_this());
+      m_csFromNdnSim->Add(cachedData);
   }
 
   NFD_LOG_DEBUG("onDataUnsolicited face=" << inFace.getId() <<
@@ -406,10 +569,8 @@ Forwarder::onOutgoingData(const Data& data, Face& outFace)
     return;
   }
 
-  // TODO traffic manager
-
-  // send Data
-  outFace.sendData(data);
+  // send Data, via the output queue if outFace is backlogged
+  m_trafficManager.sendData(outFace, data);
   ++m_counters.getNOutDatas();
 }
 
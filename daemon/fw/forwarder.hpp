@@ -36,6 +36,9 @@
 #include "table/measurements.hpp"
 #include "table/strategy-choice.hpp"
 #include "table/dead-nonce-list.hpp"
+#include "link-estimator.hpp"
+#include "traffic-manager.hpp"
+#include "interest-shaper.hpp"
 
 #include "ns3/ndnSIM/model/cs/ndn-content-store.hpp"
 
@@ -87,6 +90,27 @@ public: // forwarding entrypoints and tables
   void
   onData(Face& face, const Data& data);
 
+  /** \brief prepare tables for a batch of packets received in one operation
+   *
+   *  Name hashes of up to 16 packets are computed into stack storage, then NameTree buckets
+   *  and nodes are prefetched for each of them, so that their cache misses overlap. The packets
+   *  themselves are then delivered one at a time through onInterest and onData,
+   *  in arrival order, so per-packet semantics are unchanged.
+   */
+  void
+  onReceiveBatch(const ReceiveBatch& batch);
+
+  /** \brief drop a received packet early, from the fields decoded up front
+   *  \return false if the packet would be dropped by the incoming Interest or Data pipeline
+   *          regardless of its remaining fields
+   *
+   *  This is installed as the receive filter of every face in the FaceTable, so that
+   *  /localhost violations, Interests looping by the Dead Nonce List, and unsolicited
+   *  Data that would not be cached are dropped without decoding them completely.
+   */
+  bool
+  filterIncomingPacket(const Face& inFace, const ReceivedPacket& packet);
+
   NameTree&
   getNameTree();
 
@@ -108,6 +132,19 @@ public: // forwarding entrypoints and tables
   DeadNonceList&
   getDeadNonceList();
 
+  /** \brief per-face link quality estimates shared by all strategies
+   */
+  fw::LinkEstimator&
+  getLinkEstimator();
+
+  /** \brief shaper of outgoing Interests, where return path capacities are configured
+   *
+   *  No capacity is configured by default, so Interests are not shaped unless the
+   *  scenario calls InterestShaper::setCapacity.
+   */
+  fw::InterestShaper&
+  getInterestShaper();
+
 public: // allow enabling ndnSIM content store (will be removed in the future)
   void
   setCsFromNdnSim(ns3::Ptr<ns3::ndn::ContentStore> cs);
@@ -152,6 +189,29 @@ PUBLIC_WITH_TESTS_ELSE_PRIVATE: // pipelines
   onOutgoingInterest(shared_ptr<pit::Entry> pitEntry, Face& outFace,
                      bool wantNewNonce = false);
 
+  /** \brief insert OutRecord and send Interest, after Interest shaping
+   */
+  void
+  sendInterest(shared_ptr<pit::Entry> pitEntry, Face& outFace, const Interest& interest);
+
+  /** \brief make a copy of \p interest that carries another Nonce
+   *
+   *  The copy is decoded from a copy of the wire encoding of \p interest, in which only
+   *  the Nonce value is replaced, so that it is neither copied field by field nor encoded
+   *  again when it is sent. The wire encoding of \p interest itself is left as is,
+   *  because it can be shared with other packets.
+   *  LocalControlHeader and tags are carried over, as with the copy constructor.
+   *  \sa tests/other/interest-nonce-benchmark.cpp
+   */
+  static shared_ptr<Interest>
+  makeInterestWithNonce(const Interest& interest, uint32_t nonce);
+
+  /** \brief reject a PIT entry whose Interest was rejected by the shaper,
+   *         unless it has been forwarded elsewhere
+   */
+  void
+  onInterestShapedOut(weak_ptr<pit::Entry> pitEntry);
+
   /** \brief Interest reject pipeline
    */
   VIRTUAL_WITH_TESTS void
@@ -185,6 +245,16 @@ PUBLIC_WITH_TESTS_ELSE_PRIVATE: // pipelines
   VIRTUAL_WITH_TESTS void
   onOutgoingData(const Data& data, Face& outFace);
 
+  /** \brief get the Data to insert into the Content Store
+   *
+   *  Tags that describe how \p data was received (Ptr<Packet> with its ns-3 tags, e.g.,
+   *  hop count, and the congestion mark) must not be served from the Content Store.
+   *  \return \p data itself if it carries none of them, otherwise a copy without them;
+   *          \p data is never modified, because faces may still hold it
+   */
+  shared_ptr<const Data>
+  makeCacheableData(const Data& data);
+
 PROTECTED_WITH_TESTS_ELSE_PRIVATE:
   VIRTUAL_WITH_TESTS void
   setUnsatisfyTimer(shared_ptr<pit::Entry> pitEntry);
@@ -230,6 +300,10 @@ private:
   DeadNonceList  m_deadNonceList;
   shared_ptr<NullFace> m_csFace;
 
+  fw::LinkEstimator m_linkEstimator;
+  fw::TrafficManager m_trafficManager;
+  fw::InterestShaper m_interestShaper;
+
   ns3::Ptr<ns3::ndn::ContentStore> m_csFromNdnSim;
 
   static const Name LOCALHOST_NAME;
@@ -316,6 +390,18 @@ Forwarder::getDeadNonceList()
   return m_deadNonceList;
 }
 
+inline fw::LinkEstimator&
+Forwarder::getLinkEstimator()
+{
+  return m_linkEstimator;
+}
+
+inline fw::InterestShaper&
+Forwarder::getInterestShaper()
+{
+  return m_interestShaper;
+}
+
 inline void
 Forwarder::setCsFromNdnSim(ns3::Ptr<ns3::ndn::ContentStore> cs)
 {
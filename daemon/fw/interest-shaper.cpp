@@ -0,0 +1,210 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2014-2015,  Regents of the University of California,
+ *                           Arizona Board of Regents,
+ *                           Colorado State University,
+ *                           University Pierre & Marie Curie, Sorbonne University,
+ *                           Washington University in St. Louis,
+ *                           Beijing Institute of Technology,
+ *                           The University of Memphis.
+ *
+ * This file is part of NFD (Named Data Networking Forwarding Daemon).
+ * See AUTHORS.md for complete list of NFD authors and contributors.
+ *
+ * NFD is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * NFD is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * NFD, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+#include "interest-shaper.hpp"
+#include "core/logger.hpp"
+
+namespace nfd {
+namespace fw {
+
+NFD_LOG_INIT("InterestShaper");
+
+const time::nanoseconds InterestShaper::DEFAULT_BURST = time::milliseconds(20);
+const time::nanoseconds InterestShaper::DEFAULT_MAX_DELAY = time::milliseconds(100);
+// assume large Data until the first Data is seen, so that a new face is not overloaded
+const double InterestShaper::INITIAL_DATA_SIZE = ndn::MAX_NDN_PACKET_SIZE;
+const double InterestShaper::EWMA_WEIGHT = 0.125;
+
+static double
+toSeconds(const time::nanoseconds& d)
+{
+  return d.count() / 1000000000.0;
+}
+
+InterestShaper::InterestShaper(const time::nanoseconds& burst, const time::nanoseconds& maxDelay)
+  : m_burst(burst)
+  , m_maxDelay(maxDelay)
+{
+}
+
+void
+InterestShaper::setCapacity(Face& face, double bytesPerSecond)
+{
+  if (bytesPerSecond <= 0) {
+    this->erase(face.getId());
+    return;
+  }
+
+  unique_ptr<Bucket>& bucket = m_buckets[face.getId()];
+  if (bucket == nullptr) {
+    bucket.reset(new Bucket);
+    bucket->face = face.shared_from_this();
+    bucket->tokens = 0;
+    bucket->dataSize = INITIAL_DATA_SIZE;
+    bucket->interestSize = 0;
+  }
+  bucket->capacity = bytesPerSecond;
+  bucket->lastUpdate = time::steady_clock::now();
+  bucket->tokens = std::max(bucket->capacity * toSeconds(m_burst), INITIAL_DATA_SIZE);
+}
+
+void
+InterestShaper::refill(Bucket& bucket, const time::steady_clock::TimePoint& now) const
+{
+  double burstSize = std::max(bucket.capacity * toSeconds(m_burst), INITIAL_DATA_SIZE);
+  bucket.tokens = std::min(burstSize,
+                           bucket.tokens + bucket.capacity * toSeconds(now - bucket.lastUpdate));
+  bucket.lastUpdate = now;
+}
+
+InterestShaper::Result
+InterestShaper::shape(shared_ptr<pit::Entry> pitEntry, Face& outFace, shared_ptr<Interest> interest)
+{
+  auto it = m_buckets.find(outFace.getId());
+  if (it == m_buckets.end()) {
+    return SEND;
+  }
+  Bucket& bucket = *it->second;
+
+  time::steady_clock::TimePoint now = time::steady_clock::now();
+  this->refill(bucket, now);
+
+  double interestSize = interest->wireEncode().size();
+  if (bucket.interestSize == 0) {
+    bucket.interestSize = interestSize;
+  }
+  else {
+    bucket.interestSize += EWMA_WEIGHT * (interestSize - bucket.interestSize);
+  }
+  double expectedDataSize = bucket.dataSize / bucket.interestSize * interestSize;
+
+  if (bucket.delayed.empty() && bucket.tokens >= expectedDataSize) {
+    bucket.tokens -= expectedDataSize;
+    return SEND;
+  }
+
+  // delay until the bucket would hold enough tokens, after earlier delayed Interests
+  double deficit = std::max(expectedDataSize - bucket.tokens, 0.0);
+  time::nanoseconds delay(static_cast<time::nanoseconds::rep>(
+                            deficit / bucket.capacity * 1000000000.0));
+  if (delay > m_maxDelay) {
+    NFD_LOG_DEBUG("shape face=" << outFace.getId() << " interest=" << interest->getName() <<
+                  " reject delay=" << delay);
+    return REJECTED;
+  }
+
+  NFD_LOG_TRACE("shape face=" << outFace.getId() << " interest=" << interest->getName() <<
+                " delay=" << delay);
+  bucket.tokens -= expectedDataSize;
+  bucket.delayed.push_back({pitEntry, interest, now + delay});
+  if (bucket.delayed.size() == 1) {
+    bucket.releaseEvent = scheduler::schedule(delay, bind(&InterestShaper::release, this,
+                                                          ref(bucket)));
+  }
+  return DELAYED;
+}
+
+void
+InterestShaper::release(Bucket& bucket)
+{
+  time::steady_clock::TimePoint now = time::steady_clock::now();
+  shared_ptr<Face> face = bucket.face.lock();
+
+  std::vector<DelayedInterest> ready;
+  while (!bucket.delayed.empty() && bucket.delayed.front().sendTime <= now) {
+    ready.push_back(std::move(bucket.delayed.front()));
+    bucket.delayed.pop_front();
+  }
+
+  if (!bucket.delayed.empty()) {
+    bucket.releaseEvent = scheduler::schedule(bucket.delayed.front().sendTime - now,
+                                              bind(&InterestShaper::release, this, ref(bucket)));
+  }
+
+  if (face == nullptr) {
+    return;
+  }
+  // bucket must not be accessed below, a handler may erase it
+  for (const DelayedInterest& delayed : ready) {
+    shared_ptr<pit::Entry> pitEntry = delayed.pitEntry.lock();
+    if (pitEntry != nullptr) {
+      this->afterRelease(pitEntry, face, delayed.interest);
+    }
+  }
+}
+
+void
+InterestShaper::afterReceiveData(const Face& inFace, const Data& data)
+{
+  auto it = m_buckets.find(inFace.getId());
+  if (it == m_buckets.end()) {
+    return;
+  }
+  Bucket& bucket = *it->second;
+  bucket.dataSize += EWMA_WEIGHT * (data.wireEncode().size() - bucket.dataSize);
+}
+
+void
+InterestShaper::erase(FaceId face)
+{
+  m_buckets.erase(face);
+}
+
+size_t
+InterestShaper::getNDelayed(FaceId face) const
+{
+  auto it = m_buckets.find(face);
+  if (it == m_buckets.end()) {
+    return 0;
+  }
+  return it->second->delayed.size();
+}
+
+bool
+InterestShaper::hasDelayed(const pit::Entry& pitEntry) const
+{
+  for (const auto& bucket : m_buckets) {
+    for (const DelayedInterest& delayed : bucket.second->delayed) {
+      if (delayed.pitEntry.lock().get() == &pitEntry) {
+        return true;
+      }
+    }
+  }
+  return false;
+}
+
+double
+InterestShaper::getDataInterestRatio(FaceId face) const
+{
+  auto it = m_buckets.find(face);
+  if (it == m_buckets.end() || it->second->interestSize == 0) {
+    return 0;
+  }
+  return it->second->dataSize / it->second->interestSize;
+}
+
+} // namespace fw
+} // namespace nfd
@@ -0,0 +1,165 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2014-2015,  Regents of the University of California,
+ *                           Arizona Board of Regents,
+ *                           Colorado State University,
+ *                           University Pierre & Marie Curie, Sorbonne University,
+ *                           Washington University in St. Louis,
+ *                           Beijing Institute of Technology,
+ *                           The University of Memphis.
+ *
+ * This file is part of NFD (Named Data Networking Forwarding Daemon).
+ * See AUTHORS.md for complete list of NFD authors and contributors.
+ *
+ * NFD is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * NFD is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * NFD, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+#ifndef NFD_DAEMON_FW_INTEREST_SHAPER_HPP
+#define NFD_DAEMON_FW_INTEREST_SHAPER_HPP
+
+#include "face/face.hpp"
+#include "table/pit-entry.hpp"
+#include "core/scheduler.hpp"
+
+#include <deque>
+#include <unordered_map>
+
+namespace nfd {
+namespace fw {
+
+/** \brief the Interest shaping stage of the outgoing Interest pipeline
+ *
+ *  An Interest is small, but the Data it brings back is not, so congestion on the
+ *  return path only becomes visible once that Data is in flight.
+ *  For each face with a known return path capacity, the shaper runs a token bucket
+ *  filled at that capacity (bytes/s). Each Interest takes from the bucket the Data
+ *  bytes it is expected to pull, which is its own size times the Data-to-Interest byte
+ *  ratio observed on the face.
+ *
+ *  An Interest that finds too few tokens is delayed until the bucket would have refilled,
+ *  and is then emitted through afterRelease.
+ *  If that delay would exceed the maximum delay, the Interest is rejected instead.
+ *
+ *  Faces without a configured capacity are not shaped. Capacities are not derived from
+ *  faces, which do not know the rate of their link: until the simulation scenario sets
+ *  them with setCapacity (e.g., from the DataRate of the ns-3 channel behind a face),
+ *  the shaper lets every Interest through.
+ */
+class InterestShaper : noncopyable
+{
+public:
+  enum Result {
+    /// send the Interest now
+    SEND,
+    /// the Interest is held, and will be emitted through afterRelease
+    DELAYED,
+    /// the return path is overloaded, do not send the Interest
+    REJECTED
+  };
+
+  static const time::nanoseconds DEFAULT_BURST;
+  static const time::nanoseconds DEFAULT_MAX_DELAY;
+  static const double INITIAL_DATA_SIZE;
+  static const double EWMA_WEIGHT;
+
+  explicit
+  InterestShaper(const time::nanoseconds& burst = DEFAULT_BURST,
+                 const time::nanoseconds& maxDelay = DEFAULT_MAX_DELAY);
+
+  /** \brief set the capacity of the return path (Data direction) of face
+   *  \param bytesPerSecond the capacity; 0 disables shaping on the face
+   */
+  void
+  setCapacity(Face& face, double bytesPerSecond);
+
+  /** \brief decide whether interest can be sent to outFace
+   *
+   *  If DELAYED is returned, afterRelease fires with the same arguments once
+   *  interest may be sent, unless face has been erased meanwhile.
+   */
+  Result
+  shape(shared_ptr<pit::Entry> pitEntry, Face& outFace, shared_ptr<Interest> interest);
+
+  /** \brief learn the Data size on inFace
+   */
+  void
+  afterReceiveData(const Face& inFace, const Data& data);
+
+  /** \brief forget the state of face, discarding delayed Interests
+   */
+  void
+  erase(FaceId face);
+
+  /** \return number of Interests delayed on face
+   */
+  size_t
+  getNDelayed(FaceId face) const;
+
+  /** \return whether an Interest of pitEntry is delayed on any face
+   *
+   *  Delayed Interests have no OutRecord until they are released.
+   */
+  bool
+  hasDelayed(const pit::Entry& pitEntry) const;
+
+  /** \return expected Data-to-Interest byte ratio on face, or 0 if face is not shaped
+   */
+  double
+  getDataInterestRatio(FaceId face) const;
+
+public:
+  /** \brief fires when a delayed Interest may be sent
+   */
+  signal::Signal<InterestShaper, shared_ptr<pit::Entry>, shared_ptr<Face>,
+                 shared_ptr<Interest>> afterRelease;
+
+private:
+  struct DelayedInterest
+  {
+    weak_ptr<pit::Entry> pitEntry;
+    shared_ptr<Interest> interest;
+    time::steady_clock::TimePoint sendTime;
+  };
+
+  struct Bucket
+  {
+    weak_ptr<Face> face;
+    double capacity;
+    double tokens;
+    time::steady_clock::TimePoint lastUpdate;
+    double dataSize; ///< EWMA of Data wire size
+    double interestSize; ///< EWMA of Interest wire size
+    std::deque<DelayedInterest> delayed;
+    scheduler::ScopedEventId releaseEvent;
+  };
+
+  /** \brief add tokens accumulated since the last update, up to the burst size
+   */
+  void
+  refill(Bucket& bucket, const time::steady_clock::TimePoint& now) const;
+
+  /** \brief emit delayed Interests whose send time has come, and schedule the next release
+   */
+  void
+  release(Bucket& bucket);
+
+private:
+  const time::nanoseconds m_burst;
+  const time::nanoseconds m_maxDelay;
+  std::unordered_map<FaceId, unique_ptr<Bucket>> m_buckets;
+};
+
+} // namespace fw
+} // namespace nfd
+
+#endif // NFD_DAEMON_FW_INTEREST_SHAPER_HPP
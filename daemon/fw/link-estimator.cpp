@@ -0,0 +1,168 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2015 Klaus Schneider, University of Bamberg, Germany
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ *
+ * Author: Klaus Schneider <klaus.schneider@uni-bamberg.de>
+ */
+#include "link-estimator.hpp"
+#include "core/logger.hpp"
+
+namespace nfd {
+namespace fw {
+
+NFD_LOG_INIT("LinkEstimator");
+
+LinkEstimation::LinkEstimation(time::steady_clock::Duration window)
+  : m_window(window)
+  , m_rto(1, time::milliseconds(1), 0.1)
+  , m_nSatisfied(0)
+  , m_nLost(0)
+  , m_nMarked(0)
+  , m_nBytes(0)
+{
+}
+
+void
+LinkEstimation::addSatisfiedInterest(size_t sizeInBytes, time::microseconds rtt,
+                                     bool isCongestionMarked)
+{
+  time::steady_clock::TimePoint now = time::steady_clock::now();
+  this->evict(now);
+
+  m_samples.push_back({now, sizeInBytes, false, isCongestionMarked});
+  ++m_nSatisfied;
+  if (isCongestionMarked) {
+    ++m_nMarked;
+  }
+  m_nBytes += sizeInBytes;
+
+  m_rtt.addMeasurement(rtt);
+  m_rttQuantiles.addMeasurement(rtt);
+  m_rto.addMeasurement(rtt);
+}
+
+void
+LinkEstimation::addLostInterest()
+{
+  time::steady_clock::TimePoint now = time::steady_clock::now();
+  this->evict(now);
+
+  m_samples.push_back({now, 0, true, false});
+  ++m_nLost;
+}
+
+void
+LinkEstimation::evict(const time::steady_clock::TimePoint& now)
+{
+  time::steady_clock::TimePoint windowStart = now - m_window;
+  while (!m_samples.empty() && m_samples.front().time <= windowStart) {
+    const Sample& sample = m_samples.front();
+    if (sample.isLost) {
+      --m_nLost;
+    }
+    else {
+      --m_nSatisfied;
+      m_nBytes -= sample.nBytes;
+      if (sample.isMarked) {
+        --m_nMarked;
+      }
+    }
+    m_samples.pop_front();
+  }
+}
+
+double
+LinkEstimation::getLossPercentage()
+{
+  this->evict(time::steady_clock::now());
+
+  if (m_nLost + m_nSatisfied == 0) {
+    return 0;
+  }
+  return static_cast<double>(m_nLost) / static_cast<double>(m_nLost + m_nSatisfied);
+}
+
+double
+LinkEstimation::getCongestionMarkPercentage()
+{
+  this->evict(time::steady_clock::now());
+
+  if (m_nSatisfied == 0) {
+    return 0;
+  }
+  return static_cast<double>(m_nMarked) / static_cast<double>(m_nSatisfied);
+}
+
+double
+LinkEstimation::getKBytesPerSecond()
+{
+  this->evict(time::steady_clock::now());
+
+  double windowSeconds = time::duration_cast<time::nanoseconds>(m_window).count() / 1000000000.0;
+  return static_cast<double>(m_nBytes) / (windowSeconds * 1024);
+}
+
+double
+LinkEstimation::getCurrentValue(RequirementType type)
+{
+  switch (type) {
+  case RequirementType::BANDWIDTH:
+    return this->getKBytesPerSecond();
+  case RequirementType::DELAY:
+  case RequirementType::DELAY_P95:
+  case RequirementType::DELAY_P99:
+    // a face that lost everything is treated as unreachable
+    if (this->getLossPercentage() >= 1) {
+      return 1000 * 1000;
+    }
+    if (type == RequirementType::DELAY_P95) {
+      return this->getRttQuantileInMilliseconds(0.95);
+    }
+    if (type == RequirementType::DELAY_P99) {
+      return this->getRttQuantileInMilliseconds(0.99);
+    }
+    return this->getRttInMilliseconds();
+  case RequirementType::LOSS:
+    return this->getLossPercentage();
+  case RequirementType::CONGESTION:
+    return this->getCongestionMarkPercentage();
+  default:
+    NFD_LOG_WARN("Invalid type. Should not happen!");
+    return -1;
+  }
+}
+
+void
+LinkEstimator::afterSatisfyInterest(const Face& upstream, size_t sizeInBytes,
+                                    time::steady_clock::Duration rtt, bool isCongestionMarked)
+{
+  NFD_LOG_TRACE("afterSatisfyInterest face=" << upstream.getId() <<
+                " rtt=" << time::duration_cast<time::microseconds>(rtt).count() <<
+                (isCongestionMarked ? " marked" : ""));
+  this->get(upstream.getId()).addSatisfiedInterest(sizeInBytes,
+                                                   time::duration_cast<time::microseconds>(rtt),
+                                                   isCongestionMarked);
+}
+
+void
+LinkEstimator::afterLoseInterest(const Face& upstream)
+{
+  NFD_LOG_TRACE("afterLoseInterest face=" << upstream.getId());
+  this->get(upstream.getId()).addLostInterest();
+}
+
+} // namespace fw
+} // namespace nfd
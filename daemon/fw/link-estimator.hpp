@@ -0,0 +1,199 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2015 Klaus Schneider, University of Bamberg, Germany
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ *
+ * Author: Klaus Schneider <klaus.schneider@uni-bamberg.de>
+ */
+#ifndef NFD_DAEMON_FW_LINK_ESTIMATOR_HPP
+#define NFD_DAEMON_FW_LINK_ESTIMATOR_HPP
+
+#include "common.hpp"
+#include "face/face.hpp"
+#include "rtt-estimator.hpp"
+#include "rtt-estimator2.hpp"
+#include "rtt-quantile-estimator.hpp"
+#include "strategy-requirements.hpp"
+
+#include <deque>
+#include <unordered_map>
+
+namespace nfd {
+namespace fw {
+
+/** \brief link quality estimates (delay, loss, bandwidth) of one upstream face
+ *
+ *  All samples are fed by the Forwarder from PIT out-records, so every strategy
+ *  sees the same estimates regardless of which strategy forwarded the Interest.
+ */
+class LinkEstimation
+{
+public:
+  static const int DEFAULT_WINDOW_IN_MS = 5000;
+
+  explicit
+  LinkEstimation(time::steady_clock::Duration window =
+                   time::milliseconds(DEFAULT_WINDOW_IN_MS));
+
+  /** \brief record an Interest satisfied by this face
+   *  \param sizeInBytes Content size of the satisfying Data
+   *  \param rtt time between the last transmission on the out-record and the Data arrival
+   *  \param isCongestionMarked whether the Data carries a congestion mark
+   */
+  void
+  addSatisfiedInterest(size_t sizeInBytes, time::microseconds rtt,
+                       bool isCongestionMarked = false);
+
+  /** \brief record an Interest that was forwarded to this face but never satisfied
+   */
+  void
+  addLostInterest();
+
+  /** \return mean RTT in milliseconds
+   */
+  double
+  getRttInMilliseconds() const;
+
+  /** \return RTT quantile in milliseconds, e.g., quantile=0.99 for the 99th percentile
+   */
+  double
+  getRttQuantileInMilliseconds(double quantile) const;
+
+  /** \return fraction of lost Interests within the window, between 0 and 1
+   */
+  double
+  getLossPercentage();
+
+  /** \return fraction of satisfying Data within the window that carried a congestion mark,
+   *          between 0 and 1
+   */
+  double
+  getCongestionMarkPercentage();
+
+  /** \return received Content bytes within the window in kilobytes per second
+   */
+  double
+  getKBytesPerSecond();
+
+  /** \return the current value for the type; -1 if the type cannot be estimated
+   */
+  double
+  getCurrentValue(RequirementType type);
+
+  /** \return mean-deviation estimator, for strategies that need an RTO
+   */
+  const RttEstimator&
+  getRttEstimator() const;
+
+private:
+  void
+  evict(const time::steady_clock::TimePoint& now);
+
+private:
+  struct Sample
+  {
+    time::steady_clock::TimePoint time;
+    size_t nBytes;
+    bool isLost;
+    bool isMarked;
+  };
+
+  const time::steady_clock::Duration m_window;
+  RttEstimator2 m_rtt;
+  RttQuantileEstimator m_rttQuantiles;
+  RttEstimator m_rto;
+
+  // samples within the window, ordered by time, with running totals
+  std::deque<Sample> m_samples;
+  size_t m_nSatisfied;
+  size_t m_nLost;
+  size_t m_nMarked;
+  size_t m_nBytes;
+};
+
+inline double
+LinkEstimation::getRttInMilliseconds() const
+{
+  return m_rtt.getRttInMilliseconds();
+}
+
+inline double
+LinkEstimation::getRttQuantileInMilliseconds(double quantile) const
+{
+  return m_rttQuantiles.getQuantileInMilliseconds(quantile);
+}
+
+inline const RttEstimator&
+LinkEstimation::getRttEstimator() const
+{
+  return m_rto;
+}
+
+/** \brief Forwarder-owned per-face link estimation service
+ *
+ *  The Forwarder updates this table once per packet:
+ *  an RTT and bandwidth sample when Data satisfies an out-record,
+ *  and a loss sample for each out-record still unanswered when the PIT entry is finalized.
+ *  Strategies query it through Strategy::getLinkEstimator.
+ */
+class LinkEstimator : noncopyable
+{
+public:
+  /** \return estimation of face; a fresh estimation is created if face has no samples yet
+   */
+  LinkEstimation&
+  get(FaceId face);
+
+  void
+  afterSatisfyInterest(const Face& upstream, size_t sizeInBytes,
+                       time::steady_clock::Duration rtt, bool isCongestionMarked = false);
+
+  void
+  afterLoseInterest(const Face& upstream);
+
+  /** \brief forget all samples of face
+   */
+  void
+  erase(FaceId face);
+
+  size_t
+  size() const;
+
+private:
+  std::unordered_map<FaceId, LinkEstimation> m_table;
+};
+
+inline LinkEstimation&
+LinkEstimator::get(FaceId face)
+{
+  return m_table[face];
+}
+
+inline void
+LinkEstimator::erase(FaceId face)
+{
+  m_table.erase(face);
+}
+
+inline size_t
+LinkEstimator::size() const
+{
+  return m_table.size();
+}
+
+} // namespace fw
+} // namespace nfd
+
+#endif // NFD_DAEMON_FW_LINK_ESTIMATOR_HPP
@@ -48,8 +48,7 @@ void LowestCostStrategy::afterReceiveInterest(const Face& inFace, const Interest
     nfd::MeasurementsAccessor & ma = this->getMeasurements();
     measurementInfo = StrategyHelper::addPrefixMeasurements(interest, ma);
     NFD_LOG_WARN("New prefix " << interest.getName() << " from " << inFace.getId());
-    measurementInfo->req.parseParameters(
-        ownStrategyChoice.findEffectiveParameters(interest.getName()));
+    measurementInfo->req = ownStrategyChoice.findEffectiveParameters(*pitEntry).getRequirements();
   }
 
   if (pitEntry->hasUnexpiredOutRecords()) {
@@ -77,14 +76,13 @@ void LowestCostStrategy::afterReceiveInterest(const Face& inFace, const Interest
       measurementInfo->currentWorkingFace = outFace->getId();
     }
 
-    InterfaceEstimation& faceInfo = faceInfoTable[outFace->getId()];
+    LinkEstimation& faceInfo = this->getLinkEstimator().get(outFace->getId());
     NFD_LOG_TRACE(
         "Face: " << outFace->getId() << " - bw: "
             << faceInfo.getCurrentValue(RequirementType::BANDWIDTH) << ", delay: "
             << faceInfo.getCurrentValue(RequirementType::DELAY) << "ms, loss: "
             << faceInfo.getCurrentValue(RequirementType::LOSS));
 
-    faceInfoTable[outFace->getId()].addSentInterest(interest.getName().toUri());
     this->sendInterest(pitEntry, outFace);
   }
 }
@@ -94,23 +92,31 @@ shared_ptr<Face> LowestCostStrategy::getOutputFace(const fib::NextHopList& nexth
 {
   shared_ptr < Face > outFace = NULL;
 
-  if (requirements.contains(RequirementType::DELAY)
+  // Mean delay or one of its percentiles, whichever the prefix asks for
+  RequirementType delayType = requirements.getDelayType();
+
+  if (requirements.contains(delayType)
       && requirements.contains(RequirementType::LOSS)) {
     for (auto n : nexthops) {
       bool isWorkingFace = (n.getFace()->getId() == currentWorkingFace);
-      double currentDelay = faceInfoTable[n.getFace()->getId()].getCurrentValue(
-          RequirementType::DELAY);
-      double currentLoss = faceInfoTable[n.getFace()->getId()].getCurrentValue(
-          RequirementType::LOSS);
+      LinkEstimation& faceInfo = this->getLinkEstimator().get(n.getFace()->getId());
+      double currentDelay = faceInfo.getCurrentValue(delayType);
+      double currentLoss = faceInfo.getCurrentValue(RequirementType::LOSS);
+      double currentMarks = faceInfo.getCurrentValue(RequirementType::CONGESTION);
 
       if (pitEntry->canForwardTo(*n.getFace())) {
-        double delayLimit = requirements.getLimit(RequirementType::DELAY);
+        double delayLimit = requirements.getLimit(delayType);
         double lossLimit = requirements.getLimit(RequirementType::LOSS);
+        // Without a "maxmarks" requirement, marks never exclude a face
+        double marksLimit = requirements.contains(RequirementType::CONGESTION) ?
+            requirements.getLimit(RequirementType::CONGESTION) :
+            std::numeric_limits<double>::infinity();
         if (!isWorkingFace) {
           delayLimit /= (1.0 + HYSTERESIS_PERCENTAGE);
           lossLimit /= (1.0 + HYSTERESIS_PERCENTAGE);
+          marksLimit /= (1.0 + HYSTERESIS_PERCENTAGE);
         }
-        if (currentDelay < delayLimit && currentLoss < lossLimit) {
+        if (currentDelay < delayLimit && currentLoss < lossLimit && currentMarks <= marksLimit) {
           outFace = n.getFace();
           break;
         }
@@ -118,18 +124,24 @@ shared_ptr<Face> LowestCostStrategy::getOutputFace(const fib::NextHopList& nexth
     }
     if (outFace == NULL) {
       // Not all requirements could be met. use priority type.
-      outFace = getLowestTypeFace(nexthops, pitEntry, priorityType, requirements,
+      RequirementType fallbackType =
+          StrategyRequirements::isDelayAttribute(priorityType) ? delayType : priorityType;
+      outFace = getLowestTypeFace(nexthops, pitEntry, fallbackType, requirements,
           currentWorkingFace);
     }
   }
-  else if (requirements.contains(RequirementType::DELAY)) {
-    outFace = getLowestTypeFace(nexthops, pitEntry, RequirementType::DELAY, requirements,
+  else if (requirements.contains(delayType)) {
+    outFace = getLowestTypeFace(nexthops, pitEntry, delayType, requirements,
         currentWorkingFace);
   }
   else if (requirements.contains(RequirementType::LOSS)) {
     outFace = getLowestTypeFace(nexthops, pitEntry, RequirementType::LOSS, requirements,
         currentWorkingFace);
   }
+  else if (requirements.contains(RequirementType::CONGESTION)) {
+    outFace = getLowestTypeFace(nexthops, pitEntry, RequirementType::CONGESTION, requirements,
+        currentWorkingFace);
+  }
   else if (requirements.contains(RequirementType::BANDWIDTH)) {
     outFace = getLowestTypeFace(nexthops, pitEntry, RequirementType::BANDWIDTH, requirements, true);
   }
@@ -165,7 +177,7 @@ shared_ptr<Face> LowestCostStrategy::getLowestTypeFace(const fib::NextHopList& n
         currentLimit /= (1.0 + HYSTERESIS_PERCENTAGE);
       }
     }
-    double currentValue = faceInfoTable[n.getFace()->getId()].getCurrentValue(type);
+    double currentValue = this->getLinkEstimator().get(n.getFace()->getId()).getCurrentValue(type);
     if (pitEntry->canForwardTo(*n.getFace())) {
       if (!isUpwardAttribute && currentValue < currentLimit) {
         outFace = n.getFace();
@@ -183,7 +195,7 @@ shared_ptr<Face> LowestCostStrategy::getLowestTypeFace(const fib::NextHopList& n
     double lowestValue = std::numeric_limits<double>::infinity();
     double highestValue = -1;
     for (auto n : nexthops) {
-      double currentValue = faceInfoTable[n.getFace()->getId()].getCurrentValue(type);
+      double currentValue = this->getLinkEstimator().get(n.getFace()->getId()).getCurrentValue(type);
       if (!isUpwardAttribute && pitEntry->canForwardTo(*n.getFace())
           && currentValue < lowestValue) {
         lowestValue = currentValue;
@@ -208,34 +220,10 @@ void LowestCostStrategy::probeInterests(const shared_ptr<Face> outFace, const In
 {
   for (auto n : nexthops) {
     if (n.getFace() != outFace) {
-      faceInfoTable[n.getFace()->getId()].addSentInterest(interest.getName().toUri());
       this->sendInterest(pitEntry, n.getFace(), true);
     }
   }
 }
 
-void LowestCostStrategy::beforeSatisfyInterest(shared_ptr<pit::Entry> pitEntry, const Face& inFace,
-    const Data& data)
-{
-
-  // Update loss info!
-  InterfaceEstimation& faceInfo = faceInfoTable[inFace.getId()];
-  faceInfo.addSatisfiedInterest(data.getContent().value_size(), data.getName().toUri());
-
-  pit::OutRecordCollection::const_iterator outRecord = pitEntry->getOutRecord(inFace);
-
-  // already satisfied by another upstream
-  if (pitEntry->getInRecords().empty() || outRecord == pitEntry->getOutRecords().end()) {
-    // Do nothing else
-  }
-
-  // There is an in and outrecord: Update RTT value!
-  else {
-    time::steady_clock::Duration rtt = time::steady_clock::now() - outRecord->getLastRenewed();
-    faceInfo.addRttMeasurement(time::duration_cast < time::microseconds > (rtt));
-  }
-}
-
 }  // namespace fw
 }  // namespace nfd
-
@@ -30,7 +30,7 @@
 #include "../table/strategy-choice.hpp"
 #include "forwarder.hpp"
 #include "strategy-requirements.hpp"
-#include "interface-estimation.hpp"
+#include "link-estimator.hpp"
 
 namespace nfd {
 namespace fw {
@@ -42,6 +42,9 @@ namespace fw {
  * Current parameters:
  * \param maxloss double of loss percentage (between 0 and 1)
  * \param maxdelay double maximal round trip delay in milliseconds
+ * \param delay-p95 double maximal 95th percentile of the round trip delay in milliseconds
+ * \param delay-p99 double maximal 99th percentile of the round trip delay in milliseconds
+ * \param maxmarks double of congestion marked Data percentage (between 0 and 1)
  * \parm  minbw  minimal bandwidth in Kbps
  */
 class LowestCostStrategy : public Strategy
@@ -55,10 +58,6 @@ public:
       shared_ptr<fib::Entry> fibEntry, shared_ptr<pit::Entry> pitEntry)
   DECL_OVERRIDE;
 
-  virtual void
-  beforeSatisfyInterest(shared_ptr<pit::Entry> pitEntry, const Face& inFace, const Data& data)
-  DECL_OVERRIDE;
-
 public:
 
   static const Name STRATEGY_NAME;
@@ -94,7 +93,6 @@ private:
   const double HYSTERESIS_PERCENTAGE = 0.05;
 
   StrategyHelper helper;
-  std::unordered_map<FaceId, InterfaceEstimation> faceInfoTable;
   StrategyChoice& ownStrategyChoice;
 
   // The type to use when not all requirements can be met.
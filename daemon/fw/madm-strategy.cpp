@@ -54,8 +54,7 @@ void MadmStrategy::afterReceiveInterest(const Face& inFace, const Interest& inte
     NFD_LOG_INFO("New prefix " << interest.getName() << " from " << inFace.getId());
 
     measurementInfo = StrategyHelper::addPrefixMeasurements(interest, this->getMeasurements());
-    measurementInfo->req.parseParameters(
-        ownStrategyChoice.findEffectiveParameters(interest.getName()));
+    measurementInfo->req = ownStrategyChoice.findEffectiveParameters(*pitEntry).getRequirements();
 
     NFD_LOG_INFO(
         "Requirements: " << measurementInfo->req.getLimit(RequirementType::DELAY) << ", "
@@ -70,7 +69,7 @@ void MadmStrategy::afterReceiveInterest(const Face& inFace, const Interest& inte
 
     double totalValue = 0;
     for (auto currentType : measurementInfo->req.getOwnTypes()) {
-      InterfaceEstimation &currentFaceInfo = faceInfoTable[n.getFace()->getId()];
+      LinkEstimation& currentFaceInfo = this->getLinkEstimator().get(n.getFace()->getId());
       double currentReqValue;
       if (currentType == RequirementType::COST) {
         currentReqValue = costMap[n.getFace()->getId()].getCost();
@@ -116,8 +115,6 @@ void MadmStrategy::afterReceiveInterest(const Face& inFace, const Interest& inte
     probeInterests(outFace, interest, measurementInfo->req, fibEntry->getNextHops(), pitEntry);
   }
 
-  faceInfoTable[outFace->getId()].addSentInterest(interest.getName().toUri());
-
   if (outFace->getId() != measurementInfo->currentWorkingFace) {
     NFD_LOG_TRACE(
         "New current working face from " << measurementInfo->currentWorkingFace << " to "
@@ -169,7 +166,6 @@ void MadmStrategy::probeInterests(const shared_ptr<Face> outFace, const Interest
     }
     if (thisFace != outFace && !costTooHigh) {
       NFD_LOG_TRACE("Probing face: " << thisFace->getId());
-      faceInfoTable[thisFace->getId()].addSentInterest(interest.getName().toUri());
       this->sendInterest(pitEntry, thisFace, true);
     }
   }
@@ -178,21 +174,8 @@ void MadmStrategy::probeInterests(const shared_ptr<Face> outFace, const Interest
 void MadmStrategy::beforeSatisfyInterest(shared_ptr<pit::Entry> pitEntry, const Face& inFace,
     const Data& data)
 {
-  InterfaceEstimation& prefixInfo = faceInfoTable[inFace.getId()];
-
-  prefixInfo.addSatisfiedInterest(data.getContent().value_size(), data.getName().toUri());
+  // Delay, loss and bandwidth are estimated by the forwarder (see LinkEstimator)
   costMap[inFace.getId()].addToTraffic(data.getContent().size());
-
-  // Interest is already satisfied by another upstream
-  pit::OutRecordCollection::const_iterator outRecord = pitEntry->getOutRecord(inFace);
-  if (pitEntry->getInRecords().empty() || outRecord == pitEntry->getOutRecords().end()) {
-    // Do nothing else
-  }
-  // There is an in and outrecord: Update RTT value!
-  else {
-    time::steady_clock::Duration rtt = time::steady_clock::now() - outRecord->getLastRenewed();
-    prefixInfo.addRttMeasurement(time::duration_cast < time::microseconds > (rtt));
-  }
 }
 
 }  // Namespace fw
@@ -36,7 +36,10 @@ namespace fw {
  * \param minbw=[vl-vu] minimal acceptable bandwidth
  * \param maxcost=[vl-vu] maximal acceptable cost. Should be in the range of [0-1000]
  * \param maxdelay=[vl-vu] maximal acceptable delay in milliseconds
+ * \param delay-p95=[vl-vu] maximal acceptable 95th percentile delay in milliseconds
+ * \param delay-p99=[vl-vu] maximal acceptable 99th percentile delay in milliseconds
  * \param maxloss=[vl-vu] maximal acceptable packet loss percentage in the range of [0-1]
+ * \param maxmarks=[vl-vu] maximal acceptable congestion marked Data percentage in the range of [0-1]
  *
  */
 class MadmStrategy : public Strategy
@@ -75,7 +78,6 @@ private:
 
   StrategyHelper helper = StrategyHelper();
   StrategyChoice& ownStrategyChoice;
-  std::unordered_map<FaceId, InterfaceEstimation> faceInfoTable;
   std::unordered_map<FaceId, CostEstimator> costMap;
 
   bool initialized = false;
@@ -5,7 +5,6 @@
 #include "strategy-requirements.hpp"
 #include <unordered_map>
 #include "../face/face.hpp"
-#include "interface-estimation.hpp"
 
 namespace nfd {
 namespace fw {
@@ -27,7 +26,6 @@ public:
   }
 
 public:
-  std::unordered_map<FaceId, InterfaceEstimation> faceInfoMap;
   StrategyRequirements req;
   int currentWorkingFace;
 };
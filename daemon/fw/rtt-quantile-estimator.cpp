@@ -0,0 +1,92 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2015 Klaus Schneider, University of Bamberg, Germany
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ *
+ * Author: Klaus Schneider <klaus.schneider@uni-bamberg.de>
+ */
+#include "rtt-quantile-estimator.hpp"
+
+#include <cmath>
+
+namespace nfd {
+namespace fw {
+
+const time::microseconds RttQuantileEstimator::MIN_RTT = time::microseconds(100);
+const time::microseconds RttQuantileEstimator::MAX_RTT = time::seconds(60);
+const double RttQuantileEstimator::BUCKET_RATIO = 1.1;
+
+RttQuantileEstimator::RttQuantileEstimator(size_t maxSamples, time::microseconds initialRtt) :
+    totalCount(0), maxSamples(maxSamples), samplesSinceAging(0),
+        initialRttInMicroSec(initialRtt.count())
+{
+  buckets.fill(0);
+}
+
+size_t RttQuantileEstimator::getBucketIndex(double rttInMicroSec) const
+{
+  static const double LOG_RATIO = std::log(BUCKET_RATIO);
+
+  if (rttInMicroSec <= MIN_RTT.count()) {
+    return 0;
+  }
+  size_t index = static_cast<size_t>(std::log(rttInMicroSec / MIN_RTT.count()) / LOG_RATIO);
+  return std::min(index, N_BUCKETS - 1);
+}
+
+double RttQuantileEstimator::getBucketMidpoint(size_t index) const
+{
+  // geometric middle of [MIN_RTT * r^i, MIN_RTT * r^(i+1))
+  return MIN_RTT.count() * std::pow(BUCKET_RATIO, index + 0.5);
+}
+
+void RttQuantileEstimator::addMeasurement(time::microseconds measure)
+{
+  buckets[getBucketIndex(static_cast<double>(measure.count()))] += 1;
+  totalCount += 1;
+
+  if (++samplesSinceAging > maxSamples) {
+    age();
+  }
+}
+
+void RttQuantileEstimator::age()
+{
+  for (double& count : buckets) {
+    count /= 2;
+  }
+  totalCount /= 2;
+  samplesSinceAging = 0;
+}
+
+double RttQuantileEstimator::getQuantileInMilliseconds(double quantile) const
+{
+  if (totalCount == 0) {
+    return initialRttInMicroSec / 1000.0;
+  }
+
+  double rank = quantile * totalCount;
+  double cumulative = 0;
+  for (size_t i = 0; i < N_BUCKETS; ++i) {
+    cumulative += buckets[i];
+    if (cumulative >= rank && buckets[i] > 0) {
+      return getBucketMidpoint(i) / 1000.0;
+    }
+  }
+  return getBucketMidpoint(N_BUCKETS - 1) / 1000.0;
+}
+
+}  // namespace fw
+}  // namespace nfd
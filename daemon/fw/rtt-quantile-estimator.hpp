@@ -0,0 +1,95 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2015 Klaus Schneider, University of Bamberg, Germany
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ *
+ * Author: Klaus Schneider <klaus.schneider@uni-bamberg.de>
+ */
+#ifndef NFD_DAEMON_FW_RTT_QUANTILE_ESTIMATOR_HPP
+#define NFD_DAEMON_FW_RTT_QUANTILE_ESTIMATOR_HPP
+
+#include "common.hpp"
+
+#include <array>
+
+namespace nfd {
+namespace fw {
+
+/**
+ * \brief A streaming RTT quantile estimator (e.g., p95, p99)
+ *
+ * RTT samples are counted in a histogram of logarithmically spaced buckets
+ * between MIN_RTT and MAX_RTT, where each bucket is BUCKET_RATIO times wider than the
+ * previous one. Adding a sample costs O(1); the relative error of a quantile is bounded
+ * by the bucket width (about 5%).
+ *
+ * To follow changing link conditions, all counts are halved whenever more than
+ * maxSamples samples have been added since the last halving.
+ */
+class RttQuantileEstimator
+{
+public:
+
+  /**
+   * \param maxSamples number of samples after which old samples lose half of their weight
+   * \param initialRtt value returned by getQuantileInMilliseconds() before the first sample
+   */
+  RttQuantileEstimator(size_t maxSamples = 1000,
+      time::microseconds initialRtt = time::milliseconds(10));
+
+  /**
+   * Adds one new rtt measurement.
+   */
+  void
+  addMeasurement(time::microseconds measure);
+
+  /**
+   * Returns the estimated quantile in milliseconds.
+   *
+   * \param quantile value between 0 and 1, e.g., 0.99 for the 99th percentile
+   */
+  double
+  getQuantileInMilliseconds(double quantile) const;
+
+public:
+  static const time::microseconds MIN_RTT;
+  static const time::microseconds MAX_RTT;
+  static const double BUCKET_RATIO;
+  static const size_t N_BUCKETS = 140;
+
+private:
+
+  size_t
+  getBucketIndex(double rttInMicroSec) const;
+
+  double
+  getBucketMidpoint(size_t index) const;
+
+  void
+  age();
+
+private:
+
+  std::array<double, N_BUCKETS> buckets;
+  double totalCount;
+  const size_t maxSamples;
+  size_t samplesSinceAging;
+  const double initialRttInMicroSec;
+};
+
+}  // namespace fw
+}  // namespace nfd
+
+#endif // NFD_DAEMON_FW_RTT_QUANTILE_ESTIMATOR_HPP
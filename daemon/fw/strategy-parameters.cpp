@@ -0,0 +1,46 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2015 Klaus Schneider, University of Bamberg, Germany
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ *
+ * Author: Klaus Schneider <klaus.schneider@uni-bamberg.de>
+ */
+#include "strategy-parameters.hpp"
+#include "strategy-helper.hpp"
+
+namespace nfd {
+namespace fw {
+
+StrategyParameters::StrategyParameters(const std::string& parameterString) :
+    m_string(parameterString)
+{
+  if (!m_string.empty()) {
+    m_map = StrategyHelper::getParameterMap(m_string);
+    m_requirements.parseParameterMap(m_map);
+  }
+}
+
+std::string StrategyParameters::get(const std::string& key,
+    const std::string& defaultValue) const
+{
+  std::map<std::string, std::string>::const_iterator it = m_map.find(key);
+  if (it == m_map.end()) {
+    return defaultValue;
+  }
+  return it->second;
+}
+
+}  // namespace fw
+}  // namespace nfd
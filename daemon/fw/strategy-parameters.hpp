@@ -0,0 +1,101 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2015 Klaus Schneider, University of Bamberg, Germany
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ *
+ * Author: Klaus Schneider <klaus.schneider@uni-bamberg.de>
+ */
+#ifndef NFD_DAEMON_FW_STRATEGY_PARAMETERS_HPP
+#define NFD_DAEMON_FW_STRATEGY_PARAMETERS_HPP
+
+#include "strategy-requirements.hpp"
+
+#include <map>
+#include <string>
+
+namespace nfd {
+namespace fw {
+
+/**
+ * The parameters of a strategy choice entry, parsed once when the entry is set.
+ *
+ * Strategies obtain them through StrategyChoice::findEffectiveParameters instead of
+ * re-parsing the parameter string for every Interest.
+ */
+class StrategyParameters
+{
+public:
+
+  /**
+   * \param parameterString has the syntax "p1=v1,...pn=vn" (see StrategyHelper::getParameterMap).
+   * An empty string yields no parameters.
+   */
+  explicit
+  StrategyParameters(const std::string& parameterString = "");
+
+  /**
+   * Returns the unparsed parameter string.
+   */
+  const std::string&
+  toString() const;
+
+  /**
+   * Returns the value of a parameter, or defaultValue if it is not set.
+   *
+   * The value is returned by copy, since defaultValue may be a temporary.
+   */
+  std::string
+  get(const std::string& key, const std::string& defaultValue = "") const;
+
+  /**
+   * Returns true if the parameter is set.
+   */
+  bool
+  has(const std::string& key) const;
+
+  /**
+   * Returns the requirements (maxdelay, maxloss, ...) contained in the parameters.
+   */
+  const StrategyRequirements&
+  getRequirements() const;
+
+private:
+  std::string m_string;
+  std::map<std::string, std::string> m_map;
+  StrategyRequirements m_requirements;
+};
+
+inline const std::string&
+StrategyParameters::toString() const
+{
+  return m_string;
+}
+
+inline bool
+StrategyParameters::has(const std::string& key) const
+{
+  return m_map.count(key) > 0;
+}
+
+inline const StrategyRequirements&
+StrategyParameters::getRequirements() const
+{
+  return m_requirements;
+}
+
+}  // namespace fw
+}  // namespace nfd
+
+#endif // NFD_DAEMON_FW_STRATEGY_PARAMETERS_HPP
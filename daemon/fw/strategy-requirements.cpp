@@ -33,7 +33,7 @@ namespace nfd {
     {
     }
 
-    bool StrategyRequirements::contains(RequirementType type)
+    bool StrategyRequirements::contains(RequirementType type) const
     {
       if (requirementMap.count(type) == 0) {
         return false;
@@ -43,7 +43,7 @@ namespace nfd {
       }
     }
 
-    double StrategyRequirements::getLimit(RequirementType type) {
+    double StrategyRequirements::getLimit(RequirementType type) const {
       double first = getLimits(type).first;
       double second = getLimits(type).second;
       if (first != second) {
@@ -52,10 +52,11 @@ namespace nfd {
       return getLimits(type).first;
     }
 
-    std::pair<double, double> StrategyRequirements::getLimits(RequirementType type)
+    std::pair<double, double> StrategyRequirements::getLimits(RequirementType type) const
     {
-      if (requirementMap.count(type) != 0) {
-        return requirementMap[type];
+      auto it = requirementMap.find(type);
+      if (it != requirementMap.end()) {
+        return it->second;
       }
       else {
         return std::pair<double, double> {-1, -1};
@@ -81,21 +82,49 @@ namespace nfd {
       }
     }
 
+    bool StrategyRequirements::isDelayAttribute(RequirementType type)
+    {
+      return type == RequirementType::DELAY || type == RequirementType::DELAY_P95
+          || type == RequirementType::DELAY_P99;
+    }
+
+    RequirementType StrategyRequirements::getDelayType() const
+    {
+      if (contains(RequirementType::DELAY_P99)) {
+        return RequirementType::DELAY_P99;
+      }
+      else if (contains(RequirementType::DELAY_P95)) {
+        return RequirementType::DELAY_P95;
+      }
+      else {
+        return RequirementType::DELAY;
+      }
+    }
+
     bool StrategyRequirements::parseParameters(std::string parameterString)
     {
-      std::map < std::string, std::string > paramStringMap = StrategyHelper::getParameterMap(
-          parameterString);
+      return parseParameterMap(StrategyHelper::getParameterMap(parameterString));
+    }
 
+    bool StrategyRequirements::parseParameterMap(
+        const std::map<std::string, std::string>& paramStringMap)
+    {
       RequirementType currentType;
 
       bool foundSupported = false;
-      bool found = true;
 
       for (auto p : paramStringMap) {
+        bool found = true;
         std::string s = p.first;
         if (s.find("maxloss") != std::string::npos) {
           currentType = RequirementType::LOSS;
         }
+        else if (s.find("delay-p99") != std::string::npos) {
+          currentType = RequirementType::DELAY_P99;
+        }
+        else if (s.find("delay-p95") != std::string::npos) {
+          currentType = RequirementType::DELAY_P95;
+        }
         else if (s.find("maxdelay") != std::string::npos) {
           currentType = RequirementType::DELAY;
         }
@@ -105,6 +134,9 @@ namespace nfd {
         else if (s.find("minbw") != std::string::npos) {
           currentType = RequirementType::BANDWIDTH;
         }
+        else if (s.find("maxmarks") != std::string::npos) {
+          currentType = RequirementType::CONGESTION;
+        }
         else {
           found = false;
           NFD_LOG_WARN("Unknown parameter: " << s);
@@ -29,9 +29,16 @@
 namespace nfd {
 namespace fw {
 
+/**
+ * Requirement types.
+ *
+ * DELAY refers to the mean round trip delay; DELAY_P95 and DELAY_P99 refer to the
+ * 95th and 99th percentile of the round trip delay. CONGESTION refers to the fraction
+ * of Data that was congestion marked by an upstream output queue.
+ */
 enum class RequirementType
 {
-  BANDWIDTH, COST, DELAY, LOSS
+  BANDWIDTH, COST, DELAY, LOSS, DELAY_P95, DELAY_P99, CONGESTION
 };
 
 /**
@@ -50,28 +57,50 @@ public:
    */
   StrategyRequirements(std::set<RequirementType> supportedRequirements = {
       RequirementType::BANDWIDTH, RequirementType::COST, RequirementType::DELAY,
-      RequirementType::LOSS });
+      RequirementType::LOSS, RequirementType::DELAY_P95, RequirementType::DELAY_P99,
+      RequirementType::CONGESTION });
 
   /**
    * Returns if the given requirement is an upward or downward attribute.
    *
    * Upward attributes are BANDWIDTH (a higher value is preferable)
    *
-   * Downward attributes: LOSS, DELAY, COST (a lower value is preferable)
+   * Downward attributes: LOSS, DELAY, COST, CONGESTION (a lower value is preferable)
    */
   static bool isUpwardAttribute(RequirementType type);
 
+  /**
+   * Returns true for DELAY and the delay percentile types (DELAY_P95, DELAY_P99).
+   */
+  static bool isDelayAttribute(RequirementType type);
+
+  /**
+   * Returns the most specific delay requirement type that is instantiated:
+   * DELAY_P99 before DELAY_P95 before DELAY.
+   *
+   * Returns DELAY if no delay requirement is instantiated.
+   */
+  RequirementType getDelayType() const;
+
   /**
    * Takes a string of parameters and adds the corresponding requirement attributes and values.
    *
    * \param parameterString has the syntax "p1=v1,...pn=vn" or "p1=vl1-vl2,...".
-   * Valid names for pi are "maxloss", "mindelay", "minbw" and "mincost".
+   * Valid names for pi are "maxloss", "maxdelay", "delay-p95", "delay-p99", "minbw",
+   * "maxcost" and "maxmarks". Delay values are in milliseconds; "maxmarks" is the
+   * tolerated fraction of congestion marked Data between 0 and 1.
    *
    * \returns true if at least one parameter was valid (supported and contained in parameterString).
    * Returns false otherwise.
    */
   bool parseParameters(std::string parameterString);
 
+  /**
+   * Same as parseParameters(), but takes a parameter map that has already been
+   * parsed by StrategyHelper::getParameterMap.
+   */
+  bool parseParameterMap(const std::map<std::string, std::string>& paramStringMap);
+
   /**
    * Returns the limits for one specific requirement type.
    *
@@ -79,7 +108,7 @@ public:
    * \returns the same value for both if there is only one limit.
    * \returns std::pair<-1,-1> if the type is not instantiated.
    */
-  std::pair<double, double> getLimits(RequirementType type);
+  std::pair<double, double> getLimits(RequirementType type) const;
 
   /**
    * Returns the limit for one specific requirement type.
@@ -87,12 +116,12 @@ public:
    * Returns The lower limit if they differ and logs a warning message.
    *
    */
-  double getLimit(RequirementType type);
+  double getLimit(RequirementType type) const;
 
   /**
    * Returns true if the requirement type is supported and has an assigned value.
    */
-  bool contains(RequirementType type);
+  bool contains(RequirementType type) const;
 
   /**
    * Returns a set with all supported and instantiated requirement types.
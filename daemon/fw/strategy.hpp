@@ -135,6 +135,11 @@ protected: // accessors
   const FaceTable&
   getFaceTable();
 
+  /** \brief per-face link quality estimates maintained by the Forwarder
+   */
+  LinkEstimator&
+  getLinkEstimator();
+
 protected: // accessors
   signal::Signal<FaceTable, shared_ptr<Face>>& afterAddFace;
   signal::Signal<FaceTable, shared_ptr<Face>>& beforeRemoveFace;
@@ -189,6 +194,12 @@ Strategy::getFaceTable()
   return m_forwarder.getFaceTable();
 }
 
+inline LinkEstimator&
+Strategy::getLinkEstimator()
+{
+  return m_forwarder.getLinkEstimator();
+}
+
 } // namespace fw
 } // namespace nfd
 
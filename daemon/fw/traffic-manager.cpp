@@ -0,0 +1,255 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2014-2015,  Regents of the University of California,
+ *                           Arizona Board of Regents,
+ *                           Colorado State University,
+ *                           University Pierre & Marie Curie, Sorbonne University,
+ *                           Washington University in St. Louis,
+ *                           Beijing Institute of Technology,
+ *                           The University of Memphis.
+ *
+ * This file is part of NFD (Named Data Networking Forwarding Daemon).
+ * See AUTHORS.md for complete list of NFD authors and contributors.
+ *
+ * NFD is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * NFD is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * NFD, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+#include "traffic-manager.hpp"
+#include "face/congestion-mark-tag.hpp"
+#include "core/logger.hpp"
+
+#include <cmath>
+
+namespace nfd {
+namespace fw {
+
+NFD_LOG_INIT("TrafficManager");
+
+const time::nanoseconds CodelQueue::DEFAULT_TARGET = time::milliseconds(5);
+const time::nanoseconds CodelQueue::DEFAULT_INTERVAL = time::milliseconds(100);
+
+CodelQueue::CodelQueue(size_t limit,
+                       const time::nanoseconds& target, const time::nanoseconds& interval)
+  : m_limit(limit)
+  , m_target(target)
+  , m_interval(interval)
+  , m_length(0)
+  , m_firstAboveTime(time::steady_clock::TimePoint::min())
+  , m_dropNext()
+  , m_count(0)
+  , m_lastCount(0)
+  , m_isDropping(false)
+{
+}
+
+bool
+CodelQueue::enqueue(shared_ptr<const Data> data)
+{
+  size_t size = data->wireEncode().size();
+  if (m_length + size > m_limit) {
+    return false;
+  }
+
+  m_items.push_back({data, time::steady_clock::now(), size});
+  m_length += size;
+  return true;
+}
+
+bool
+CodelQueue::doDequeue(const time::steady_clock::TimePoint& now, Item& item, bool& isOkToDrop)
+{
+  isOkToDrop = false;
+  if (m_items.empty()) {
+    m_firstAboveTime = time::steady_clock::TimePoint::min();
+    return false;
+  }
+
+  item = std::move(m_items.front());
+  m_items.pop_front();
+  m_length -= item.size;
+
+  time::nanoseconds sojourn = now - item.enqueueTime;
+  // never drop when less than one packet is left, the link cannot be kept busy otherwise
+  if (sojourn < m_target || m_length <= ndn::MAX_NDN_PACKET_SIZE) {
+    m_firstAboveTime = time::steady_clock::TimePoint::min();
+  }
+  else if (m_firstAboveTime == time::steady_clock::TimePoint::min()) {
+    m_firstAboveTime = now + m_interval;
+  }
+  else if (now >= m_firstAboveTime) {
+    isOkToDrop = true;
+  }
+  return true;
+}
+
+time::steady_clock::TimePoint
+CodelQueue::controlLaw(const time::steady_clock::TimePoint& t) const
+{
+  return t + time::nanoseconds(static_cast<time::nanoseconds::rep>(
+               m_interval.count() / std::sqrt(static_cast<double>(m_count))));
+}
+
+CodelQueue::DequeueResult
+CodelQueue::dequeue()
+{
+  time::steady_clock::TimePoint now = time::steady_clock::now();
+  DequeueResult result{nullptr, time::nanoseconds::zero(), 0};
+
+  Item item;
+  bool isOkToDrop = false;
+  if (!this->doDequeue(now, item, isOkToDrop)) {
+    m_isDropping = false;
+    return result;
+  }
+
+  if (m_isDropping) {
+    if (!isOkToDrop) {
+      // sojourn time went below target, leave dropping state
+      m_isDropping = false;
+    }
+    while (m_isDropping && now >= m_dropNext) {
+      ++result.nDropped;
+      ++m_count;
+      if (!this->doDequeue(now, item, isOkToDrop)) {
+        m_isDropping = false;
+        return result;
+      }
+      if (!isOkToDrop) {
+        m_isDropping = false;
+      }
+      else {
+        m_dropNext = this->controlLaw(m_dropNext);
+      }
+    }
+  }
+  else if (isOkToDrop) {
+    ++result.nDropped;
+    bool hasNext = this->doDequeue(now, item, isOkToDrop);
+    m_isDropping = true;
+
+    // if the last dropping state ended recently, resume at its drop rate
+    size_t delta = m_count - m_lastCount;
+    if (delta > 1 && now - m_dropNext < 16 * m_interval) {
+      m_count = delta;
+    }
+    else {
+      m_count = 1;
+    }
+    m_dropNext = this->controlLaw(now);
+    m_lastCount = m_count;
+
+    if (!hasNext) {
+      return result;
+    }
+  }
+
+  result.data = std::move(item.data);
+  result.sojourn = now - item.enqueueTime;
+  return result;
+}
+
+const size_t TrafficManager::DEFAULT_LIMIT = 256 * 1024;
+const size_t TrafficManager::DEFAULT_TRANSMIT_WINDOW = ndn::MAX_NDN_PACKET_SIZE;
+
+TrafficManager::TrafficManager(size_t limit, size_t transmitWindow)
+  : m_limit(limit)
+  , m_transmitWindow(transmitWindow)
+{
+}
+
+void
+TrafficManager::sendData(Face& outFace, const Data& data)
+{
+  auto it = m_queues.find(outFace.getId());
+  bool hasBacklog = it != m_queues.end() && !it->second->codel.empty();
+
+  if (!hasBacklog && outFace.getSendQueueLength() < m_transmitWindow) {
+    outFace.sendData(data);
+    return;
+  }
+
+  if (it == m_queues.end()) {
+    unique_ptr<Queue> queue(new Queue(m_limit));
+    Queue& q = *queue;
+    queue->transmitCompleteConn = outFace.onTransmitComplete.connect([this, &outFace, &q] {
+      this->transmit(outFace, q);
+    });
+    it = m_queues.emplace(outFace.getId(), std::move(queue)).first;
+  }
+
+  if (!it->second->codel.enqueue(data.shared_from_this())) {
+    NFD_LOG_DEBUG("sendData face=" << outFace.getId() << " data=" << data.getName() <<
+                  " queue full");
+    ++outFace.getMutableCounters().getNOutDataDrops();
+    return;
+  }
+
+  this->transmit(outFace, *it->second);
+}
+
+void
+TrafficManager::transmit(Face& face, Queue& queue)
+{
+  // Face::sendData may complete synchronously and emit onTransmitComplete
+  if (queue.isTransmitting) {
+    return;
+  }
+  queue.isTransmitting = true;
+
+  FaceCounters& counters = face.getMutableCounters();
+  while (!queue.codel.empty() && face.getSendQueueLength() < m_transmitWindow) {
+    CodelQueue::DequeueResult result = queue.codel.dequeue();
+    if (result.nDropped > 0) {
+      NFD_LOG_DEBUG("transmit face=" << face.getId() << " codel-drop=" << result.nDropped);
+      counters.getNOutDataDrops().set(counters.getNOutDataDrops() + result.nDropped);
+    }
+    if (result.data == nullptr) {
+      break;
+    }
+
+    ++counters.getNQueuedDatas();
+    counters.getQueueDelay() += result.sojourn;
+
+    if (result.sojourn >= queue.codel.getTarget()) {
+      // the same Data may go unmarked to other downstreams, so mark a copy
+      shared_ptr<Data> marked = make_shared<Data>(*result.data);
+      marked->setTag(make_shared<CongestionMarkTag>());
+      ++counters.getNOutCongestionMarks();
+      face.sendData(*marked);
+    }
+    else {
+      face.sendData(*result.data);
+    }
+  }
+
+  queue.isTransmitting = false;
+}
+
+void
+TrafficManager::erase(FaceId face)
+{
+  m_queues.erase(face);
+}
+
+size_t
+TrafficManager::getQueueSize(FaceId face) const
+{
+  auto it = m_queues.find(face);
+  if (it == m_queues.end()) {
+    return 0;
+  }
+  return it->second->codel.size();
+}
+
+} // namespace fw
+} // namespace nfd
@@ -0,0 +1,224 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2014-2015,  Regents of the University of California,
+ *                           Arizona Board of Regents,
+ *                           Colorado State University,
+ *                           University Pierre & Marie Curie, Sorbonne University,
+ *                           Washington University in St. Louis,
+ *                           Beijing Institute of Technology,
+ *                           The University of Memphis.
+ *
+ * This file is part of NFD (Named Data Networking Forwarding Daemon).
+ * See AUTHORS.md for complete list of NFD authors and contributors.
+ *
+ * NFD is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * NFD is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * NFD, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+#ifndef NFD_DAEMON_FW_TRAFFIC_MANAGER_HPP
+#define NFD_DAEMON_FW_TRAFFIC_MANAGER_HPP
+
+#include "face/face.hpp"
+
+#include <deque>
+#include <unordered_map>
+
+namespace nfd {
+namespace fw {
+
+/** \brief a byte-limited FIFO of Data with CoDel active queue management
+ *
+ *  CoDel (RFC 8289) drops from the head of the queue when the time packets spent
+ *  in the queue (sojourn time) has stayed above target for at least interval,
+ *  and increases the drop rate until the standing queue disappears.
+ *  Data arriving when the queue is over its byte limit are dropped from the tail.
+ */
+class CodelQueue : noncopyable
+{
+public:
+  static const time::nanoseconds DEFAULT_TARGET;
+  static const time::nanoseconds DEFAULT_INTERVAL;
+
+  explicit
+  CodelQueue(size_t limit,
+             const time::nanoseconds& target = DEFAULT_TARGET,
+             const time::nanoseconds& interval = DEFAULT_INTERVAL);
+
+  /** \brief append data to the tail of the queue
+   *  \return false if data is dropped because the queue would exceed its byte limit
+   */
+  bool
+  enqueue(shared_ptr<const Data> data);
+
+  struct DequeueResult
+  {
+    /** \brief Data to send, or nullptr if the queue became empty
+     */
+    shared_ptr<const Data> data;
+
+    /** \brief time data spent in the queue
+     */
+    time::nanoseconds sojourn;
+
+    /** \brief number of Data dropped by CoDel during this dequeue
+     */
+    size_t nDropped;
+  };
+
+  /** \brief remove Data from the head of the queue, dropping some of them if CoDel decides so
+   */
+  DequeueResult
+  dequeue();
+
+  bool
+  empty() const;
+
+  /** \return target queueing delay, above which Data is marked as congested
+   */
+  const time::nanoseconds&
+  getTarget() const;
+
+  /** \return number of Data in the queue
+   */
+  size_t
+  size() const;
+
+  /** \return number of bytes in the queue
+   */
+  size_t
+  getLength() const;
+
+private:
+  struct Item
+  {
+    shared_ptr<const Data> data;
+    time::steady_clock::TimePoint enqueueTime;
+    size_t size;
+  };
+
+  /** \brief pop the head, and determine whether CoDel is allowed to drop it
+   */
+  bool
+  doDequeue(const time::steady_clock::TimePoint& now, Item& item, bool& isOkToDrop);
+
+  time::steady_clock::TimePoint
+  controlLaw(const time::steady_clock::TimePoint& t) const;
+
+private:
+  const size_t m_limit;
+  const time::nanoseconds m_target;
+  const time::nanoseconds m_interval;
+
+  std::deque<Item> m_items;
+  size_t m_length;
+
+  // CoDel state
+  time::steady_clock::TimePoint m_firstAboveTime; ///< TimePoint::min() if sojourn is below target
+  time::steady_clock::TimePoint m_dropNext;
+  size_t m_count;
+  size_t m_lastCount;
+  bool m_isDropping;
+};
+
+inline bool
+CodelQueue::empty() const
+{
+  return m_items.empty();
+}
+
+inline const time::nanoseconds&
+CodelQueue::getTarget() const
+{
+  return m_target;
+}
+
+inline size_t
+CodelQueue::size() const
+{
+  return m_items.size();
+}
+
+inline size_t
+CodelQueue::getLength() const
+{
+  return m_length;
+}
+
+/** \brief the traffic manager stage of the outgoing Data pipeline
+ *
+ *  Data are passed straight to a face as long as its own send buffer
+ *  (Face::getSendQueueLength) holds less than one transmit window.
+ *  Beyond that, Data wait in a per-face CodelQueue, and are released to the face
+ *  as it reports progress through Face::onTransmitComplete.
+ *  This bounds the latency added by a slow downstream, instead of letting the face's
+ *  own send buffer grow without limit.
+ *
+ *  Data that waited longer than the CoDel target are sent with a CongestionMarkTag,
+ *  so that the next hop learns about the congestion before Data are dropped.
+ *
+ *  Drops, marks and queueing delay are recorded in the face's QueueCounters.
+ */
+class TrafficManager : noncopyable
+{
+public:
+  static const size_t DEFAULT_LIMIT;
+  static const size_t DEFAULT_TRANSMIT_WINDOW;
+
+  explicit
+  TrafficManager(size_t limit = DEFAULT_LIMIT,
+                 size_t transmitWindow = DEFAULT_TRANSMIT_WINDOW);
+
+  /** \brief send data to outFace now, or queue it if outFace is backlogged
+   */
+  void
+  sendData(Face& outFace, const Data& data);
+
+  /** \brief discard the queue of face
+   */
+  void
+  erase(FaceId face);
+
+  /** \return number of Data queued for face
+   */
+  size_t
+  getQueueSize(FaceId face) const;
+
+private:
+  struct Queue
+  {
+    explicit
+    Queue(size_t limit)
+      : codel(limit)
+      , isTransmitting(false)
+    {
+    }
+
+    CodelQueue codel;
+    signal::ScopedConnection transmitCompleteConn;
+    bool isTransmitting;
+  };
+
+  /** \brief release queued Data to face while its send buffer has room
+   */
+  void
+  transmit(Face& face, Queue& queue);
+
+private:
+  const size_t m_limit;
+  const size_t m_transmitWindow;
+  std::unordered_map<FaceId, unique_ptr<Queue>> m_queues;
+};
+
+} // namespace fw
+} // namespace nfd
+
+#endif // NFD_DAEMON_FW_TRAFFIC_MANAGER_HPP
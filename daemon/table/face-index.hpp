@@ -0,0 +1,108 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2014-2015,  Regents of the University of California,
+ *                           Arizona Board of Regents,
+ *                           Colorado State University,
+ *                           University Pierre & Marie Curie, Sorbonne University,
+ *                           Washington University in St. Louis,
+ *                           Beijing Institute of Technology,
+ *                           The University of Memphis.
+ *
+ * This file is part of NFD (Named Data Networking Forwarding Daemon).
+ * See AUTHORS.md for complete list of NFD authors and contributors.
+ *
+ * NFD is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * NFD is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * NFD, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+#ifndef NFD_DAEMON_TABLE_FACE_INDEX_HPP
+#define NFD_DAEMON_TABLE_FACE_INDEX_HPP
+
+#include "face/face.hpp"
+
+#include <unordered_map>
+#include <unordered_set>
+
+namespace nfd {
+
+/** \brief maps each face to the table entries that refer to it
+ *
+ *  A table entry (fib::Entry or pit::Entry) adds itself when it gains a record for a face,
+ *  and removes itself when its last record for that face goes away. Cleanup after a face
+ *  is removed then visits only the entries that refer to the face, instead of enumerating
+ *  the whole NameTree.
+ *
+ *  \tparam E table entry type
+ */
+template<typename E>
+class FaceIndex : noncopyable
+{
+public:
+  void
+  add(const Face& face, E& entry)
+  {
+    auto it = m_index.find(&face);
+    if (it == m_index.end()) {
+      it = m_index.emplace(&face, std::unordered_set<E*>()).first;
+      it->second.reserve(INITIAL_BUCKETS);
+    }
+    it->second.insert(&entry);
+  }
+
+  /** \brief removes entry from the index of face
+   *
+   *  The set of face is kept even when it becomes empty, so that a face whose entries come
+   *  and go does not reallocate it; it is released by extract() when the face is removed.
+   */
+  void
+  remove(const Face& face, E& entry)
+  {
+    auto it = m_index.find(&face);
+    if (it != m_index.end()) {
+      it->second.erase(&entry);
+    }
+  }
+
+  /** \brief removes face from the index
+   *  \return entries that referred to face
+   */
+  std::vector<E*>
+  extract(const Face& face)
+  {
+    std::vector<E*> entries;
+    auto it = m_index.find(&face);
+    if (it != m_index.end()) {
+      entries.assign(it->second.begin(), it->second.end());
+      m_index.erase(it);
+    }
+    return entries;
+  }
+
+  /** \return number of entries that refer to face
+   */
+  size_t
+  count(const Face& face) const
+  {
+    auto it = m_index.find(&face);
+    return it == m_index.end() ? 0 : it->second.size();
+  }
+
+private:
+  /// buckets reserved for the entries of a face when it is first indexed
+  static const size_t INITIAL_BUCKETS = 64;
+
+  std::unordered_map<const Face*, std::unordered_set<E*>> m_index;
+};
+
+} // namespace nfd
+
+#endif // NFD_DAEMON_TABLE_FACE_INDEX_HPP
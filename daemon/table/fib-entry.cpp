@@ -30,6 +30,7 @@ namespace fib {
 
 Entry::Entry(const Name& prefix)
   : m_prefix(prefix)
+  , m_faceIndex(nullptr)
 {
 }
 
@@ -56,6 +57,9 @@ Entry::addNextHop(shared_ptr<Face> face, uint64_t cost)
     m_nextHops.push_back(fib::NextHop(face));
     it = m_nextHops.end();
     --it;
+    if (m_faceIndex != nullptr) {
+      m_faceIndex->add(*face, *this);
+    }
   }
   // now it refers to the NextHop for face
 
@@ -70,6 +74,9 @@ Entry::removeNextHop(shared_ptr<Face> face)
   auto it = this->findNextHop(*face);
   if (it != m_nextHops.end()) {
     m_nextHops.erase(it);
+    if (m_faceIndex != nullptr) {
+      m_faceIndex->remove(*face, *this);
+    }
   }
 }
 
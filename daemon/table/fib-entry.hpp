@@ -27,10 +27,12 @@
 #define NFD_DAEMON_TABLE_FIB_ENTRY_HPP
 
 #include "fib-nexthop.hpp"
+#include "face-index.hpp"
 
 namespace nfd {
 
 class NameTree;
+class Fib;
 namespace name_tree {
 class Entry;
 }
@@ -105,9 +107,13 @@ private:
   Name m_prefix;
   NextHopList m_nextHops;
 
+  /// reverse index of the Fib that owns this entry, or nullptr if not owned by a Fib
+  FaceIndex<Entry>* m_faceIndex;
+
   shared_ptr<name_tree::Entry> m_nameTreeEntry;
   friend class nfd::NameTree;
   friend class nfd::name_tree::Entry;
+  friend class nfd::Fib;
 };
 
 
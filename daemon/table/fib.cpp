@@ -124,6 +124,7 @@ Fib::insert(const Name& prefix)
   if (static_cast<bool>(entry))
     return std::make_pair(entry, false);
   entry = make_shared<fib::Entry>(prefix);
+  entry->m_faceIndex = &m_faceIndex;
   nameTreeEntry->setFibEntry(entry);
   ++m_nItems;
   return std::make_pair(entry, true);
@@ -132,6 +133,12 @@ Fib::insert(const Name& prefix)
 void
 Fib::erase(shared_ptr<name_tree::Entry> nameTreeEntry)
 {
+  fib::Entry& entry = *nameTreeEntry->getFibEntry();
+  for (const fib::NextHop& nexthop : entry.getNextHops()) {
+    m_faceIndex.remove(*nexthop.getFace(), entry);
+  }
+  entry.m_faceIndex = nullptr;
+
   nameTreeEntry->setFibEntry(shared_ptr<fib::Entry>());
   m_nameTree.eraseEntryIfEmpty(nameTreeEntry);
   --m_nItems;
@@ -158,22 +165,12 @@ Fib::erase(const fib::Entry& entry)
 void
 Fib::removeNextHopFromAllEntries(shared_ptr<Face> face)
 {
-  std::list<fib::Entry*> toErase;
-
-  auto&& enumerable = m_nameTree.fullEnumerate(&predicate_NameTreeEntry_hasFibEntry);
-  for (const name_tree::Entry& nte : enumerable) {
-    shared_ptr<fib::Entry> entry = nte.getFibEntry();
+  for (fib::Entry* entry : m_faceIndex.extract(*face)) {
     entry->removeNextHop(face);
     if (!entry->hasNextHops()) {
-      toErase.push_back(entry.get());
-      // entry needs to be erased, but we must wait until the enumeration ends,
-      // because otherwise NameTree iterator would be invalidated
+      this->erase(*entry);
     }
   }
-
-  for (fib::Entry* entry : toErase) {
-    this->erase(*entry);
-  }
 }
 
 Fib::const_iterator
@@ -86,6 +86,7 @@ public: // mutation
    *
    *  This is usually invoked when face goes away.
    *  Removing the last NextHop in a FIB entry will erase the FIB entry.
+   *  Only entries that have a NextHop for face are visited.
    *
    *  \todo change parameter type to Face&
    */
@@ -152,6 +153,7 @@ private:
 private:
   NameTree& m_nameTree;
   size_t m_nItems;
+  FaceIndex<fib::Entry> m_faceIndex;
 
   /** \brief The empty FIB entry.
    *
@@ -35,6 +35,7 @@
 namespace nfd {
 
 class NameTree;
+class StrategyChoice;
 
 namespace name_tree {
 
@@ -138,11 +139,19 @@ private:
   shared_ptr<measurements::Entry> m_measurementsEntry;
   shared_ptr<strategy_choice::Entry> m_strategyChoiceEntry;
 
+  // Effective StrategyChoice entry cached by StrategyChoice,
+  // valid only if m_strategyChoiceGeneration equals StrategyChoice's current generation.
+  // The pointer is never dereferenced after the generation changes,
+  // so it does not need to keep the StrategyChoice entry alive.
+  strategy_choice::Entry* m_effectiveStrategyChoiceEntry;
+  uint64_t m_strategyChoiceGeneration;
+
   // get the Name Tree Node that is associated with this Name Tree Entry
   Node* m_node;
 
   // Make private members accessible by Name Tree
   friend class nfd::NameTree;
+  friend class nfd::StrategyChoice;
 };
 
 inline const Name&
@@ -31,6 +31,12 @@
 #include <boost/concept_check.hpp>
 #include <type_traits>
 
+#if defined(__GNUC__)
+#define NFD_NAME_TREE_PREFETCH(addr) __builtin_prefetch(addr)
+#else
+#define NFD_NAME_TREE_PREFETCH(addr)
+#endif
+
 namespace nfd {
 
 NFD_LOG_INIT("NameTree");
@@ -309,6 +315,42 @@ NameTree::findLongestPrefixMatch(const Name& prefix, const name_tree::EntrySelec
   return entry;
 }
 
+size_t
+NameTree::prefetchBuckets(const Name& prefix, size_t (&hashValues)[MAX_PREFETCH_DEPTH]) const
+{
+  prefix.wireEncode();  // guarantees prefix's wire buffer is not empty
+
+  // same hash values as computeHashSet, but only the last MAX_PREFETCH_DEPTH are kept
+  size_t firstKept = prefix.size() + 1 > MAX_PREFETCH_DEPTH ?
+                     prefix.size() + 1 - MAX_PREFETCH_DEPTH : 0;
+  size_t nHashValues = 0;
+  size_t hashValue = 0;
+  for (size_t i = 0; i <= prefix.size(); ++i) {
+    if (i > 0) {
+      const Name::Component& component = prefix[i - 1];
+      hashValue ^= name_tree::CityHash::compute(reinterpret_cast<const char*>(component.wire()),
+                                                component.size());
+    }
+    if (i >= firstKept) {
+      hashValues[nHashValues++] = hashValue;
+      NFD_NAME_TREE_PREFETCH(&m_buckets[hashValue % m_nBuckets]);
+    }
+  }
+  return nHashValues;
+}
+
+void
+NameTree::prefetchNodes(const size_t* hashValues, size_t nHashValues) const
+{
+  for (size_t i = 0; i < nHashValues; ++i) {
+    name_tree::Node* node = m_buckets[hashValues[i] % m_nBuckets];
+    if (node != 0) {
+      // node->m_entry is not followed: it would stall on the node being prefetched
+      NFD_NAME_TREE_PREFETCH(node);
+    }
+  }
+}
+
 shared_ptr<name_tree::Entry>
 NameTree::findLongestPrefixMatch(shared_ptr<name_tree::Entry> entry,
                                  const name_tree::EntrySelector& entrySelector) const
@@ -191,6 +191,32 @@ public: // matching
   findAllMatches(const Name& prefix,
                  const name_tree::EntrySelector& entrySelector = name_tree::AnyEntry()) const;
 
+public: // prefetching
+  /** \brief max number of prefixes of a name whose buckets are prefetched
+   */
+  static const size_t MAX_PREFETCH_DEPTH = 8;
+
+  /** \brief issue prefetches for the hash buckets of prefix and its longest ancestors
+   *  \param[out] hashValues receives the hash values of up to MAX_PREFETCH_DEPTH longest
+   *                         prefixes of prefix, including prefix itself
+   *  \return number of hash values written to hashValues
+   *
+   *  The longest prefixes are the ones visited first by exact-match lookups and longest
+   *  prefix matches. Hash values are written to caller-provided storage, so that
+   *  prefetching does not allocate.
+   *  A batch of packets should call this for every packet before prefetchNodes,
+   *  so that the cache misses of different packets overlap.
+   */
+  size_t
+  prefetchBuckets(const Name& prefix, size_t (&hashValues)[MAX_PREFETCH_DEPTH]) const;
+
+  /** \brief issue prefetches for the first node in each bucket of hashValues
+   *  \param hashValues as written by prefetchBuckets
+   *  \param nHashValues as returned by prefetchBuckets
+   */
+  void
+  prefetchNodes(const size_t* hashValues, size_t nHashValues) const;
+
 public: // enumeration
   /** \brief Enumerate all entries, optionally filtered by an EntrySelector.
    *  \return an unspecified type that have .begin() and .end() methods
@@ -34,6 +34,7 @@ const Name Entry::LOCALHOP_NAME("ndn:/localhop");
 
 Entry::Entry(const Interest& interest)
   : m_interest(interest.shared_from_this())
+  , m_faceIndex(nullptr)
 {
 }
 
@@ -135,6 +136,9 @@ Entry::insertOrUpdateInRecord(shared_ptr<Face> face, const Interest& interest)
   if (it == m_inRecords.end()) {
     m_inRecords.emplace_front(face);
     it = m_inRecords.begin();
+    if (m_faceIndex != nullptr) {
+      m_faceIndex->add(*face, *this);
+    }
   }
 
   it->update(interest);
@@ -148,10 +152,25 @@ Entry::getInRecord(const Face& face) const
     [&face] (const InRecord& inRecord) { return inRecord.getFace().get() == &face; });
 }
 
+void
+Entry::deleteInRecord(const Face& face)
+{
+  auto it = std::find_if(m_inRecords.begin(), m_inRecords.end(),
+    [&face] (const InRecord& inRecord) { return inRecord.getFace().get() == &face; });
+  if (it != m_inRecords.end()) {
+    m_inRecords.erase(it);
+    this->unindexFace(face);
+  }
+}
+
 void
 Entry::deleteInRecords()
 {
-  m_inRecords.clear();
+  InRecordCollection inRecords;
+  inRecords.swap(m_inRecords);
+  for (const InRecord& inRecord : inRecords) {
+    this->unindexFace(*inRecord.getFace());
+  }
 }
 
 OutRecordCollection::iterator
@@ -162,6 +181,9 @@ Entry::insertOrUpdateOutRecord(shared_ptr<Face> face, const Interest& interest)
   if (it == m_outRecords.end()) {
     m_outRecords.emplace_front(face);
     it = m_outRecords.begin();
+    if (m_faceIndex != nullptr) {
+      m_faceIndex->add(*face, *this);
+    }
   }
 
   it->update(interest);
@@ -182,6 +204,7 @@ Entry::deleteOutRecord(const Face& face)
     [&face] (const OutRecord& outRecord) { return outRecord.getFace().get() == &face; });
   if (it != m_outRecords.end()) {
     m_outRecords.erase(it);
+    this->unindexFace(face);
   }
 }
 
@@ -194,5 +217,15 @@ Entry::hasUnexpiredOutRecords() const
     [&now] (const OutRecord& outRecord) { return outRecord.getExpiry() >= now; });
 }
 
+void
+Entry::unindexFace(const Face& face)
+{
+  if (m_faceIndex != nullptr &&
+      this->getInRecord(face) == m_inRecords.end() &&
+      this->getOutRecord(face) == m_outRecords.end()) {
+    m_faceIndex->remove(face, *this);
+  }
+}
+
 } // namespace pit
 } // namespace nfd
@@ -29,10 +29,12 @@
 #include "pit-in-record.hpp"
 #include "pit-out-record.hpp"
 #include "core/scheduler.hpp"
+#include "face-index.hpp"
 
 namespace nfd {
 
 class NameTree;
+class Pit;
 
 namespace name_tree {
 class Entry;
@@ -132,6 +134,10 @@ public: // InRecord
   InRecordCollection::const_iterator
   getInRecord(const Face& face) const;
 
+  /// deletes one InRecord for face if exists
+  void
+  deleteInRecord(const Face& face);
+
   /// deletes all InRecords
   void
   deleteInRecords();
@@ -167,11 +173,20 @@ public:
   scheduler::EventId m_unsatisfyTimer;
   scheduler::EventId m_stragglerTimer;
 
+private:
+  /** \brief removes this entry from the face index, if it has no record for face left
+   */
+  void
+  unindexFace(const Face& face);
+
 private:
   shared_ptr<const Interest> m_interest;
   InRecordCollection m_inRecords;
   OutRecordCollection m_outRecords;
 
+  /// reverse index of the Pit that owns this entry, or nullptr if not owned by a Pit
+  FaceIndex<Entry>* m_faceIndex;
+
   static const Name LOCALHOST_NAME;
   static const Name LOCALHOP_NAME;
 
@@ -179,6 +194,7 @@ private:
 
   friend class nfd::NameTree;
   friend class nfd::name_tree::Entry;
+  friend class nfd::Pit;
 };
 
 inline const Interest&
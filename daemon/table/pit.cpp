@@ -82,6 +82,7 @@ Pit::insert(const Interest& interest)
   }
 
   shared_ptr<pit::Entry> entry = make_shared<pit::Entry>(interest);
+  entry->m_faceIndex = &m_faceIndex;
   nameTreeEntry->insertPitEntry(entry);
   m_nItems++;
   return { entry, true };
@@ -110,12 +111,29 @@ Pit::erase(shared_ptr<pit::Entry> pitEntry)
   shared_ptr<name_tree::Entry> nameTreeEntry = m_nameTree.get(*pitEntry);
   BOOST_ASSERT(static_cast<bool>(nameTreeEntry));
 
+  for (const pit::InRecord& inRecord : pitEntry->getInRecords()) {
+    m_faceIndex.remove(*inRecord.getFace(), *pitEntry);
+  }
+  for (const pit::OutRecord& outRecord : pitEntry->getOutRecords()) {
+    m_faceIndex.remove(*outRecord.getFace(), *pitEntry);
+  }
+  pitEntry->m_faceIndex = nullptr;
+
   nameTreeEntry->erasePitEntry(pitEntry);
   m_nameTree.eraseEntryIfEmpty(nameTreeEntry);
 
   --m_nItems;
 }
 
+void
+Pit::deleteFaceRecords(const Face& face)
+{
+  for (pit::Entry* entry : m_faceIndex.extract(face)) {
+    entry->deleteInRecord(face);
+    entry->deleteOutRecord(face);
+  }
+}
+
 Pit::const_iterator
 Pit::begin() const
 {
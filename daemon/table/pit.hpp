@@ -78,6 +78,14 @@ public:
   void
   erase(shared_ptr<pit::Entry> pitEntry);
 
+  /** \brief deletes the InRecords and OutRecords of face in all entries
+   *
+   *  This is invoked when face goes away. Only entries that have a record for face are
+   *  visited; the entries themselves are kept until their timers fire.
+   */
+  void
+  deleteFaceRecords(const Face& face);
+
 public: // enumeration
   class const_iterator;
 
@@ -137,6 +145,7 @@ public: // enumeration
 private:
   NameTree& m_nameTree;
   size_t m_nItems;
+  FaceIndex<pit::Entry> m_faceIndex;
 };
 
 inline size_t
@@ -27,6 +27,7 @@
 #define NFD_DAEMON_TABLE_STRATEGY_CHOICE_ENTRY_HPP
 
 #include "common.hpp"
+#include "fw/strategy-parameters.hpp"
 
 namespace nfd {
 
@@ -59,16 +60,23 @@ public:
   void
   setStrategy(fw::Strategy& strategy);
 
-  std::string
+  const std::string&
   getParameters() const;
 
+  /** \brief get parameters parsed when they were set
+   */
+  const fw::StrategyParameters&
+  getParsedParameters() const;
+
+  /** \brief set and parse parameters
+   */
   void
-  setParameters(std::string parameters);
+  setParameters(const std::string& parameters);
 
 private:
   Name m_prefix;
   fw::Strategy* m_strategy;
-  std::string m_parameters;
+  fw::StrategyParameters m_parameters;
 
   shared_ptr<name_tree::Entry> m_nameTreeEntry;
   friend class nfd::NameTree;
@@ -95,17 +103,22 @@ Entry::setStrategy(fw::Strategy& strategy)
   m_strategy = &strategy;
 }
 
-inline std::string
+inline const std::string&
 Entry::getParameters() const
 {
-//  BOOST_ASSERT(m_parameters.size() != 0);
+  return m_parameters.toString();
+}
+
+inline const fw::StrategyParameters&
+Entry::getParsedParameters() const
+{
   return m_parameters;
 }
 
 inline void
-Entry::setParameters(std::string parameters)
+Entry::setParameters(const std::string& parameters)
 {
-  m_parameters = parameters;
+  m_parameters = fw::StrategyParameters(parameters);
 }
 
 } // namespace strategy_choice
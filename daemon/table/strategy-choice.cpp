@@ -39,6 +39,7 @@ NFD_LOG_INIT("StrategyChoice");
 StrategyChoice::StrategyChoice(NameTree& nameTree, shared_ptr<Strategy> defaultStrategy)
   : m_nameTree(nameTree)
   , m_nItems(0)
+  , m_generation(1)
 {
   this->setDefaultStrategy(defaultStrategy);
 }
@@ -132,6 +133,7 @@ StrategyChoice::insert(const Name& prefix, const Name& strategyName)
   entry->setStrategy(*strategy);
   // Use last element after "/" as parameter string
   entry->setParameters(strVector.back());
+  ++m_generation;
   return true;
 }
 
@@ -158,6 +160,7 @@ StrategyChoice::erase(const Name& prefix)
   nte->setStrategyChoiceEntry(shared_ptr<Entry>());
   m_nameTree.eraseEntryIfEmpty(nte);
   --m_nItems;
+  ++m_generation;
 }
 
 std::pair<bool, Name>
@@ -188,33 +191,54 @@ StrategyChoice::findEffectiveStrategy(const Name& prefix) const
   return nte->getStrategyChoiceEntry()->getStrategy();
 }
 
-std::string
+const std::string&
 StrategyChoice::findEffectiveParameters(const Name& prefix) const
 {
-  shared_ptr < name_tree::Entry > nte = m_nameTree.findLongestPrefixMatch(prefix,
-      [] (const name_tree::Entry& entry) {
-        return static_cast<bool>(entry.getStrategyChoiceEntry());
-      });
+  shared_ptr<name_tree::Entry> nte = m_nameTree.findLongestPrefixMatch(prefix,
+    [] (const name_tree::Entry& entry) {
+      return static_cast<bool>(entry.getStrategyChoiceEntry());
+    });
 
   BOOST_ASSERT(static_cast<bool>(nte));
   return nte->getStrategyChoiceEntry()->getParameters();
 }
 
+const fw::StrategyParameters&
+StrategyChoice::findEffectiveParameters(const pit::Entry& pitEntry) const
+{
+  shared_ptr<name_tree::Entry> nte = m_nameTree.get(pitEntry);
+
+  BOOST_ASSERT(static_cast<bool>(nte));
+  return this->findEffectiveEntry(nte).getParsedParameters();
+}
 
-Strategy&
-StrategyChoice::findEffectiveStrategy(shared_ptr<name_tree::Entry> nte) const
+strategy_choice::Entry&
+StrategyChoice::findEffectiveEntry(const shared_ptr<name_tree::Entry>& nte) const
 {
+  if (nte->m_strategyChoiceGeneration == m_generation) {
+    return *nte->m_effectiveStrategyChoiceEntry;
+  }
+
   shared_ptr<strategy_choice::Entry> entry = nte->getStrategyChoiceEntry();
-  if (static_cast<bool>(entry))
-    return entry->getStrategy();
+  if (!static_cast<bool>(entry)) {
+    shared_ptr<name_tree::Entry> lpm = m_nameTree.findLongestPrefixMatch(nte,
+      [] (const name_tree::Entry& entry) {
+        return static_cast<bool>(entry.getStrategyChoiceEntry());
+      });
 
-  nte = m_nameTree.findLongestPrefixMatch(nte,
-    [] (const name_tree::Entry& entry) {
-      return static_cast<bool>(entry.getStrategyChoiceEntry());
-    });
+    BOOST_ASSERT(static_cast<bool>(lpm));
+    entry = lpm->getStrategyChoiceEntry();
+  }
 
-  BOOST_ASSERT(static_cast<bool>(nte));
-  return nte->getStrategyChoiceEntry()->getStrategy();
+  nte->m_effectiveStrategyChoiceEntry = entry.get();
+  nte->m_strategyChoiceGeneration = m_generation;
+  return *entry;
+}
+
+Strategy&
+StrategyChoice::findEffectiveStrategy(shared_ptr<name_tree::Entry> nte) const
+{
+  return this->findEffectiveEntry(nte).getStrategy();
 }
 
 Strategy&
@@ -249,6 +273,7 @@ StrategyChoice::setDefaultStrategy(shared_ptr<Strategy> strategy)
   NFD_LOG_INFO("setDefaultStrategy " << strategy->getName());
 
   entry->setStrategy(*strategy);
+  ++m_generation;
 }
 
 static inline void
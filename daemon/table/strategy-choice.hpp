@@ -101,8 +101,17 @@ public: // effective strategy
   fw::Strategy&
   findEffectiveStrategy(const measurements::Entry& measurementsEntry) const;
 
-  // find effective strategy parameters for prefix
-  std::string findEffectiveParameters(const Name& prefix) const;
+  /// get effective strategy parameters string for prefix
+  const std::string&
+  findEffectiveParameters(const Name& prefix) const;
+
+  /** \brief get effective strategy parameters for pitEntry
+   *
+   *  The parameters are parsed once when the StrategyChoice entry is set,
+   *  and the lookup is cached on the NameTree entry like findEffectiveStrategy.
+   */
+  const fw::StrategyParameters&
+  findEffectiveParameters(const pit::Entry& pitEntry) const;
 
 public: // enumeration
   class const_iterator
@@ -161,6 +170,14 @@ private:
                  fw::Strategy& oldStrategy,
                  fw::Strategy& newStrategy);
 
+  /** \brief get effective StrategyChoice entry of nte
+   *
+   *  The result is cached on nte, and reused until the next insert or erase
+   *  changes the table generation.
+   */
+  strategy_choice::Entry&
+  findEffectiveEntry(const shared_ptr<name_tree::Entry>& nte) const;
+
   fw::Strategy&
   findEffectiveStrategy(shared_ptr<name_tree::Entry> nte) const;
 
@@ -168,6 +185,9 @@ private:
   NameTree& m_nameTree;
   size_t m_nItems;
 
+  /// incremented whenever a change may alter the effective entry of any prefix
+  uint64_t m_generation;
+
   typedef std::map<Name, shared_ptr<fw::Strategy> > StrategyInstanceTable;
   StrategyInstanceTable m_strategyInstances;
 };
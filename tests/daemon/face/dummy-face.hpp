@@ -83,6 +83,14 @@ public:
     this->emitSignal(onReceiveData, data);
   }
 
+  /** \brief receive an encoded packet, as a face does from its transport
+   */
+  bool
+  receiveWire(const Block& element)
+  {
+    return this->decodeAndDispatchInput(element);
+  }
+
   signal::Signal<DummyFaceImpl<FaceBase>> afterSend;
 
 public:
@@ -0,0 +1,149 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2014-2015,  Regents of the University of California,
+ *                           Arizona Board of Regents,
+ *                           Colorado State University,
+ *                           University Pierre & Marie Curie, Sorbonne University,
+ *                           Washington University in St. Louis,
+ *                           Beijing Institute of Technology,
+ *                           The University of Memphis.
+ *
+ * This file is part of NFD (Named Data Networking Forwarding Daemon).
+ * See AUTHORS.md for complete list of NFD authors and contributors.
+ *
+ * NFD is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * NFD is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * NFD, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "common.hpp"
+
+#ifdef HAVE_TPACKET_V3
+
+#include "face/ethernet-packet-ring.hpp"
+
+#include "tests/test-common.hpp"
+
+#include <cstdlib>  // for std::system()
+#include <cstring>  // for std::memcpy()
+#include <net/if.h> // for if_nametoindex()
+#include <poll.h>   // for poll()
+
+namespace nfd {
+namespace tests {
+
+/** \brief creates a veth pair, so that frames sent on one end are received on the other
+ *
+ *  Creating network interfaces requires CAP_NET_ADMIN.
+ */
+class VethPairFixture : protected BaseFixture
+{
+protected:
+  VethPairFixture()
+  {
+    isAvailable =
+      std::system("ip link add nfd-ring0 type veth peer name nfd-ring1 2>/dev/null") == 0 &&
+      std::system("ip link set nfd-ring0 up && ip link set nfd-ring1 up") == 0;
+  }
+
+  ~VethPairFixture()
+  {
+    if (std::system("ip link del nfd-ring0 2>/dev/null") != 0) {
+      BOOST_TEST_MESSAGE("Cannot delete veth pair");
+    }
+  }
+
+protected:
+  bool isAvailable;
+};
+
+BOOST_FIXTURE_TEST_SUITE(FaceEthernetPacketRing, VethPairFixture)
+
+static const size_t PAYLOAD_LENGTH = 100;
+static const size_t FRAME_LENGTH = ethernet::HDR_LEN + PAYLOAD_LENGTH;
+
+static void
+writeFrame(uint8_t* frame, uint32_t seq)
+{
+  static const uint8_t header[ethernet::HDR_LEN]{
+    0xff, 0xff, 0xff, 0xff, 0xff, 0xff, // destination address
+    0x02, 0x00, 0x00, 0x00, 0x00, 0x01, // source address
+    0x86, 0x24                          // NDN ethertype
+  };
+  uint8_t* payload = std::copy_n(header, ethernet::HDR_LEN, frame);
+  std::fill_n(payload, PAYLOAD_LENGTH, static_cast<uint8_t>(seq));
+  std::memcpy(payload, &seq, sizeof(seq));
+}
+
+BOOST_AUTO_TEST_CASE(SendReceive)
+{
+  if (!isAvailable) {
+    BOOST_TEST_MESSAGE("This test case needs CAP_NET_ADMIN to create a veth pair, skipping");
+    return;
+  }
+
+  EthernetPacketRing sender(FRAME_LENGTH);
+  EthernetPacketRing receiver(FRAME_LENGTH);
+  sender.bind(::if_nametoindex("nfd-ring0"), ethernet::ETHERTYPE_NDN);
+  receiver.bind(::if_nametoindex("nfd-ring1"), ethernet::ETHERTYPE_NDN);
+
+  // returns the next free slot, flushing when every slot holds a frame that was not sent
+  auto allocateFrame = [&sender] () -> uint8_t* {
+    uint8_t* frame = sender.allocateFrame();
+    for (int i = 0; frame == nullptr && i < 1000; ++i) {
+      BOOST_REQUIRE(sender.flush());
+      ::poll(nullptr, 0, 1);
+      frame = sender.allocateFrame();
+    }
+    BOOST_REQUIRE(frame != nullptr);
+    return frame;
+  };
+
+  // more frames than there are transmit slots, so that slots are reused, and a malformed
+  // frame among them, which must not block the slots after it
+  static const uint32_t N_FRAMES = 1000;
+  static const uint32_t MALFORMED_FRAME = 10;
+  for (uint32_t seq = 0; seq < N_FRAMES; ++seq) {
+    if (seq == MALFORMED_FRAME) {
+      allocateFrame();
+      sender.commitFrame(ethernet::HDR_LEN / 2); // shorter than an Ethernet header
+    }
+    writeFrame(allocateFrame(), seq);
+    sender.commitFrame(FRAME_LENGTH);
+  }
+  BOOST_REQUIRE(sender.flush());
+
+  std::vector<uint32_t> received;
+  auto onFrame = [&received] (const uint8_t* frame, size_t length) {
+    BOOST_REQUIRE_EQUAL(length, FRAME_LENGTH);
+    uint32_t seq = 0;
+    std::memcpy(&seq, frame + ethernet::HDR_LEN, sizeof(seq));
+    BOOST_CHECK_EQUAL(frame[FRAME_LENGTH - 1], static_cast<uint8_t>(seq));
+    received.push_back(seq);
+  };
+
+  for (int i = 0; received.size() < N_FRAMES && i < 1000; ++i) {
+    pollfd pfd{receiver.getFd(), POLLIN, 0};
+    ::poll(&pfd, 1, 10);
+    receiver.receive(onFrame);
+  }
+
+  BOOST_REQUIRE_EQUAL(received.size(), N_FRAMES);
+  for (uint32_t seq = 0; seq < N_FRAMES; ++seq) {
+    BOOST_CHECK_EQUAL(received[seq], seq);
+  }
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+
+} // namespace tests
+} // namespace nfd
+
+#endif // HAVE_TPACKET_V3
@@ -96,6 +96,106 @@ BOOST_AUTO_TEST_CASE(FailTwice)
   BOOST_CHECK_EQUAL(face.failCount, 1);
 }
 
+class BatchTestFace : public DummyFace
+{
+public:
+  using DummyFace::decodeAndDispatchInput;
+};
+
+BOOST_AUTO_TEST_CASE(ReceiveBatch)
+{
+  BatchTestFace face;
+  std::vector<std::string> events;
+  face.beforeReceiveBatch.connect([&events] (const ReceiveBatch& batch) {
+    events.push_back("batch " + std::to_string(batch.size()));
+  });
+  face.onReceiveInterest.connect([&events] (const Interest& interest) {
+    events.push_back("interest " + interest.getName().toUri());
+  });
+  face.onReceiveData.connect([&events] (const Data& data) {
+    events.push_back("data " + data.getName().toUri());
+  });
+
+  std::vector<Block> elements;
+  elements.push_back(makeInterest("/A")->wireEncode());
+  elements.push_back(ndn::makeEmptyBlock(0xfe));
+  elements.push_back(makeData("/B")->wireEncode());
+  elements.push_back(makeInterest("/C")->wireEncode());
+
+  BOOST_CHECK_EQUAL(face.decodeAndDispatchInput(elements), 1);
+  BOOST_REQUIRE_EQUAL(events.size(), 4);
+  BOOST_CHECK_EQUAL(events[0], "batch 3");
+  BOOST_CHECK_EQUAL(events[1], "interest /A");
+  BOOST_CHECK_EQUAL(events[2], "data /B");
+  BOOST_CHECK_EQUAL(events[3], "interest /C");
+  BOOST_CHECK_EQUAL(face.getCounters().getNInInterests(), 2);
+  BOOST_CHECK_EQUAL(face.getCounters().getNInDatas(), 1);
+
+  // a single packet is dispatched without a batch
+  events.clear();
+  elements.assign(1, makeInterest("/D")->wireEncode());
+  BOOST_CHECK_EQUAL(face.decodeAndDispatchInput(elements), 0);
+  BOOST_REQUIRE_EQUAL(events.size(), 1);
+  BOOST_CHECK_EQUAL(events[0], "interest /D");
+}
+
+BOOST_AUTO_TEST_CASE(LazyDecoding)
+{
+  DummyFace face;
+  std::vector<ReceivedPacket> filtered;
+  face.setReceiveFilter([&filtered] (const ReceivedPacket& packet) {
+    filtered.push_back(packet);
+    return !Name("/drop").isPrefixOf(packet.name);
+  });
+  size_t nInterests = 0;
+  size_t nDatas = 0;
+  face.onReceiveInterest.connect([&nInterests] (const Interest&) { ++nInterests; });
+  face.onReceiveData.connect([&nDatas] (const Data&) { ++nDatas; });
+
+  // fields needed up front are decoded before the filter, in the receive buffer
+  shared_ptr<Interest> interest = makeInterest("/A/B");
+  interest->setMustBeFresh(true);
+  interest->setNonce(0x6e5b12a4);
+  interest->setInterestLifetime(time::milliseconds(1500));
+  BOOST_CHECK(face.receiveWire(interest->wireEncode()));
+  BOOST_REQUIRE_EQUAL(filtered.size(), 1);
+  BOOST_CHECK_EQUAL(filtered[0].name, "/A/B");
+  BOOST_CHECK_EQUAL(filtered[0].nonce, interest->getNonce());
+  BOOST_CHECK_EQUAL(filtered[0].hasSelectors, true);
+  BOOST_CHECK_EQUAL(filtered[0].interestLifetime, time::milliseconds(1500));
+  BOOST_CHECK(filtered[0].wire.getBuffer() == interest->wireEncode().getBuffer());
+  // Name is parsed within wire, so the complete decoding does not parse it again
+  BOOST_CHECK_EQUAL(filtered[0].wire.get(tlv::Name).elements_size(), 2);
+  BOOST_CHECK(filtered[0].interest == nullptr);
+  BOOST_CHECK_EQUAL(nInterests, 1);
+
+  // a dropped packet is counted, but not decoded completely
+  shared_ptr<Data> data = make_shared<Data>("/drop/C");
+  data->setFreshnessPeriod(time::seconds(10));
+  signData(data);
+  BOOST_CHECK(face.receiveWire(data->wireEncode()));
+  BOOST_REQUIRE_EQUAL(filtered.size(), 2);
+  BOOST_CHECK_EQUAL(filtered[1].freshnessPeriod, time::seconds(10));
+  BOOST_CHECK_EQUAL(nDatas, 0);
+  BOOST_CHECK_EQUAL(face.getCounters().getNInDatas(), 1);
+
+  // a packet whose remaining fields are malformed is rejected when it is dispatched
+  Block incomplete(tlv::Data);
+  incomplete.push_back(Name("/E").wireEncode());
+  incomplete.push_back(ndn::makeEmptyBlock(tlv::Content));
+  incomplete.encode();
+  BOOST_CHECK(!face.receiveWire(incomplete));
+  BOOST_CHECK_EQUAL(filtered.size(), 3);
+  BOOST_CHECK_EQUAL(nDatas, 0);
+
+  // a packet without Name is rejected up front
+  Block nameless(tlv::Interest);
+  nameless.push_back(ndn::makeEmptyBlock(tlv::Nonce));
+  nameless.encode();
+  BOOST_CHECK(!face.receiveWire(nameless));
+  BOOST_CHECK_EQUAL(filtered.size(), 3);
+}
+
 BOOST_AUTO_TEST_SUITE_END()
 
 } // namespace tests
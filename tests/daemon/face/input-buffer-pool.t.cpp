@@ -0,0 +1,72 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2014-2015,  Regents of the University of California,
+ *                           Arizona Board of Regents,
+ *                           Colorado State University,
+ *                           University Pierre & Marie Curie, Sorbonne University,
+ *                           Washington University in St. Louis,
+ *                           Beijing Institute of Technology,
+ *                           The University of Memphis.
+ *
+ * This file is part of NFD (Named Data Networking Forwarding Daemon).
+ * See AUTHORS.md for complete list of NFD authors and contributors.
+ *
+ * NFD is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * NFD is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * NFD, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+#include "face/input-buffer-pool.hpp"
+
+#include "tests/test-common.hpp"
+
+namespace nfd {
+namespace tests {
+
+BOOST_FIXTURE_TEST_SUITE(FaceInputBufferPool, BaseFixture)
+
+BOOST_AUTO_TEST_CASE(Reuse)
+{
+  InputBufferPool pool(2);
+  BOOST_CHECK_EQUAL(pool.size(), 0);
+
+  InputBufferPool::Buffer buffer1 = pool.acquire();
+  BOOST_REQUIRE(buffer1 != nullptr);
+  uint8_t* address1 = buffer1.get();
+  pool.release(std::move(buffer1));
+  BOOST_CHECK_EQUAL(pool.size(), 1);
+
+  {
+    InputBufferPool::Lease lease(pool);
+    BOOST_CHECK_EQUAL(lease.get(), address1);
+    BOOST_CHECK_EQUAL(pool.size(), 0);
+  }
+  BOOST_CHECK_EQUAL(pool.size(), 1);
+}
+
+BOOST_AUTO_TEST_CASE(MaxIdle)
+{
+  InputBufferPool pool(2);
+
+  std::vector<InputBufferPool::Buffer> buffers;
+  for (int i = 0; i < 5; ++i) {
+    buffers.push_back(pool.acquire());
+  }
+  for (InputBufferPool::Buffer& buffer : buffers) {
+    pool.release(std::move(buffer));
+  }
+  BOOST_CHECK_EQUAL(pool.size(), 2);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+
+} // namespace tests
+} // namespace nfd
@@ -154,6 +154,57 @@ BOOST_AUTO_TEST_CASE(Slice4)
   BOOST_CHECK_EQUAL(totalPayloadSize, block.size());
 }
 
+// slice a Block into fragments that refer to it
+BOOST_AUTO_TEST_CASE(SliceNoCopy)
+{
+  uint8_t blockValue[5050];
+  memset(blockValue, 0xcc, sizeof(blockValue));
+  Block block = ndn::dataBlock(0x01, blockValue, sizeof(blockValue));
+
+  ndnlp::Slicer slicer(1500);
+  ndnlp::FragmentArray fragments;
+  slicer.slice(block, fragments, 7);
+  BOOST_REQUIRE_EQUAL(fragments.size(), 4);
+
+  size_t totalPayloadSize = 0;
+  for (size_t i = 0; i < 4; ++i) {
+    const ndnlp::Fragment& fragment = fragments[i];
+    BOOST_CHECK_LE(fragment.size(), 1500);
+    BOOST_CHECK(fragment.getPayload() == block.wire() + totalPayloadSize);
+    totalPayloadSize += fragment.getPayloadSize();
+
+    // the header and the payload make up the same packet as slice(block)
+    ndn::Buffer pktWire(fragment.getHeader(), fragment.getHeaderSize());
+    pktWire.insert(pktWire.end(), fragment.getPayload(),
+                   fragment.getPayload() + fragment.getPayloadSize());
+    Block pkt(pktWire.buf(), pktWire.size());
+    BOOST_CHECK_EQUAL(pkt.type(), static_cast<uint32_t>(tlv::NdnlpData));
+    pkt.parse();
+
+    const Block::element_container& elements = pkt.elements();
+    BOOST_REQUIRE_EQUAL(elements.size(), i == 0 ? 5 : 4);
+    BOOST_CHECK_EQUAL(ndn::readNonNegativeInteger(elements[1]), i);
+    BOOST_CHECK_EQUAL(ndn::readNonNegativeInteger(elements[2]), 4);
+    if (i == 0) {
+      BOOST_CHECK_EQUAL(elements[3].type(), static_cast<uint32_t>(tlv::NdnlpCongestionMark));
+      BOOST_CHECK_EQUAL(ndn::readNonNegativeInteger(elements[3]), 7);
+    }
+
+    const Block& payloadElement = elements.back();
+    BOOST_CHECK_EQUAL(payloadElement.type(), static_cast<uint32_t>(tlv::NdnlpPayload));
+    BOOST_CHECK_EQUAL(payloadElement.value_size(), fragment.getPayloadSize());
+  }
+  BOOST_CHECK_EQUAL(totalPayloadSize, block.size());
+
+  // a small packet is not divided, and the array is reused
+  Block smallBlock = ndn::dataBlock(0x01, blockValue, 60);
+  slicer.slice(smallBlock, fragments);
+  BOOST_REQUIRE_EQUAL(fragments.size(), 1);
+  BOOST_CHECK(fragments[0].getPayload() == smallBlock.wire());
+  BOOST_CHECK_EQUAL(fragments[0].getPayloadSize(), smallBlock.size());
+  BOOST_CHECK_EQUAL(fragments[0].getHeaderSize(), 14);
+}
+
 class ReassembleFixture : protected UnitTestTimeFixture
 {
 protected:
@@ -161,8 +212,9 @@ protected:
     : slicer(1500)
     , pms(time::milliseconds(100))
   {
-    pms.onReceive.connect([this] (const Block& block) {
+    pms.onReceive.connect([this] (const Block& block, uint64_t congestionMark) {
       received.push_back(block);
+      receivedMarks.push_back(congestionMark);
     });
   }
 
@@ -192,6 +244,8 @@ protected:
 
   // received network layer packets
   std::vector<Block> received;
+  // congestion marks of received network layer packets
+  std::vector<uint64_t> receivedMarks;
 };
 
 // reassemble one fragment into one Block
@@ -209,6 +263,39 @@ BOOST_FIXTURE_TEST_CASE(Reassemble1, ReassembleFixture)
                                 block.begin(),          block.end());
 }
 
+// congestion mark is carried on the first fragment and delivered with the reassembled Block
+BOOST_FIXTURE_TEST_CASE(ReassembleCongestionMark, ReassembleFixture)
+{
+  Block block = makeBlock(5050);
+  ndnlp::PacketArray pa = slicer.slice(block, 1);
+  BOOST_REQUIRE_EQUAL(pa->size(), 4);
+
+  bool isOk = false;
+  ndnlp::NdnlpData pkt;
+  std::tie(isOk, pkt) = ndnlp::NdnlpData::fromBlock(pa->at(0));
+  BOOST_REQUIRE(isOk);
+  BOOST_CHECK_EQUAL(pkt.congestionMark, 1);
+  std::tie(isOk, pkt) = ndnlp::NdnlpData::fromBlock(pa->at(1));
+  BOOST_REQUIRE(isOk);
+  BOOST_CHECK_EQUAL(pkt.congestionMark, 0);
+
+  // first fragment arrives last
+  for (size_t i = 4; i > 0; --i) {
+    this->receiveNdnlpData(pa->at(i - 1));
+  }
+
+  Block block2 = makeBlock(60);
+  ndnlp::PacketArray pa2 = slicer.slice(block2);
+  BOOST_REQUIRE_EQUAL(pa2->size(), 1);
+  this->receiveNdnlpData(pa2->at(0));
+
+  BOOST_REQUIRE_EQUAL(received.size(), 2);
+  BOOST_CHECK_EQUAL_COLLECTIONS(received.at(0).begin(), received.at(0).end(),
+                                block.begin(),          block.end());
+  BOOST_CHECK_EQUAL(receivedMarks.at(0), 1);
+  BOOST_CHECK_EQUAL(receivedMarks.at(1), 0);
+}
+
 // reassemble four and two fragments into two Blocks
 BOOST_FIXTURE_TEST_CASE(Reassemble4and2, ReassembleFixture)
 {
@@ -299,6 +386,83 @@ BOOST_FIXTURE_TEST_CASE(ReassembleTimeout, ReassembleFixture)
                                 block.begin(),          block.end());
 }
 
+// last fragment arrives first, before the size of other fragments is known
+BOOST_FIXTURE_TEST_CASE(ReassembleLastFirst, ReassembleFixture)
+{
+  Block block = makeBlock(5050);
+  ndnlp::PacketArray pa = slicer.slice(block);
+  BOOST_REQUIRE_EQUAL(pa->size(), 4);
+
+  this->receiveNdnlpData(pa->at(3));
+  BOOST_CHECK_EQUAL(pms.size(), 1);
+  BOOST_CHECK_GT(pms.getMemoryUsage(), 0);
+  BOOST_CHECK_LT(pms.getMemoryUsage(), 1500);
+
+  for (size_t i = 0; i < 3; ++i) {
+    this->receiveNdnlpData(pa->at(i));
+  }
+
+  BOOST_REQUIRE_EQUAL(received.size(), 1);
+  BOOST_CHECK_EQUAL_COLLECTIONS(received.at(0).begin(), received.at(0).end(),
+                                block.begin(),          block.end());
+  BOOST_CHECK_EQUAL(pms.size(), 0);
+  BOOST_CHECK_EQUAL(pms.getMemoryUsage(), 0);
+}
+
+// the least recently active partial message is dropped when memory is exhausted
+BOOST_FIXTURE_TEST_CASE(ReassembleMemoryLimit, UnitTestTimeFixture)
+{
+  ndnlp::Slicer slicer(1500);
+  ndnlp::PartialMessageStore pms(time::milliseconds(100), 10000);
+  std::vector<Block> received;
+  pms.onReceive.connect([&received] (const Block& block, uint64_t) { received.push_back(block); });
+
+  auto receive = [&pms] (const Block& pkt, uint64_t senderId) {
+    bool isOk = false;
+    ndnlp::NdnlpData data;
+    std::tie(isOk, data) = ndnlp::NdnlpData::fromBlock(pkt);
+    BOOST_REQUIRE(isOk);
+    pms.receive(data, senderId);
+  };
+
+  uint8_t blockValue[5050];
+  memset(blockValue, 0xcc, sizeof(blockValue));
+  Block block = ndn::dataBlock(0x01, blockValue, sizeof(blockValue));
+  ndnlp::PacketArray pa1 = slicer.slice(block);
+  ndnlp::PacketArray pa2 = slicer.slice(block);
+  BOOST_REQUIRE_EQUAL(pa1->size(), 4);
+
+  // each message takes 4 fragments of buffer, so the second one evicts the first
+  receive(pa1->at(0), 1);
+  BOOST_CHECK_EQUAL(pms.size(), 1);
+  BOOST_CHECK_LE(pms.getMemoryUsage(), 10000);
+  receive(pa2->at(0), 2);
+  BOOST_CHECK_EQUAL(pms.size(), 1);
+  BOOST_CHECK_LE(pms.getMemoryUsage(), 10000);
+
+  for (size_t i = 1; i < 4; ++i) {
+    receive(pa2->at(i), 2);
+  }
+  BOOST_REQUIRE_EQUAL(received.size(), 1);
+  BOOST_CHECK_EQUAL(pms.size(), 0);
+  BOOST_CHECK_EQUAL(pms.getMemoryUsage(), 0);
+  BOOST_CHECK_EQUAL_COLLECTIONS(received.at(0).begin(), received.at(0).end(),
+                                block.begin(),          block.end());
+
+  // a message that cannot be a valid packet is not buffered
+  ndnlp::Slicer bigSlicer(9000);
+  std::vector<uint8_t> bigValue(ndn::MAX_NDN_PACKET_SIZE * 2);
+  Block bigBlock = ndn::dataBlock(0x01, bigValue.data(), bigValue.size());
+  ndnlp::PacketArray pa3 = bigSlicer.slice(bigBlock);
+  BOOST_REQUIRE_GT(pa3->size(), 1);
+  receive(pa3->at(0), 3);
+  BOOST_CHECK_EQUAL(pms.getMemoryUsage(), 0);
+
+  // idle partial messages are dropped by the sweeping timer
+  this->advanceClocks(time::milliseconds(10), time::milliseconds(300));
+  BOOST_CHECK_EQUAL(pms.size(), 0);
+}
+
 BOOST_AUTO_TEST_SUITE_END()
 
 } // namespace tests
@@ -0,0 +1,76 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2014-2015,  Regents of the University of California,
+ *                           Arizona Board of Regents,
+ *                           Colorado State University,
+ *                           University Pierre & Marie Curie, Sorbonne University,
+ *                           Washington University in St. Louis,
+ *                           Beijing Institute of Technology,
+ *                           The University of Memphis.
+ *
+ * This file is part of NFD (Named Data Networking Forwarding Daemon).
+ * See AUTHORS.md for complete list of NFD authors and contributors.
+ *
+ * NFD is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * NFD is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * NFD, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+#include "fw/downstream-set.hpp"
+#include "fw/forwarder.hpp"
+
+#include "tests/test-common.hpp"
+#include "tests/daemon/face/dummy-face.hpp"
+
+namespace nfd {
+namespace fw {
+namespace tests {
+
+using namespace nfd::tests;
+
+BOOST_FIXTURE_TEST_SUITE(FwDownstreamSet, BaseFixture)
+
+BOOST_AUTO_TEST_CASE(InsertionOrder)
+{
+  Forwarder forwarder;
+  std::vector<shared_ptr<Face>> faces;
+  for (size_t i = 0; i < DownstreamSet::N_INLINE + 4; ++i) {
+    faces.push_back(make_shared<DummyFace>());
+    forwarder.addFace(faces.back());
+  }
+  // a face without FaceId is compared by address
+  shared_ptr<Face> unregistered = make_shared<DummyFace>();
+
+  DownstreamSet set;
+  for (size_t i = faces.size(); i > 0; --i) {
+    BOOST_CHECK(set.insert(faces[i - 1]));
+  }
+  BOOST_CHECK(set.insert(unregistered));
+  for (const shared_ptr<Face>& face : faces) {
+    BOOST_CHECK(!set.insert(face));
+  }
+  BOOST_CHECK(!set.insert(unregistered));
+  BOOST_CHECK_EQUAL(set.size(), faces.size() + 1);
+
+  std::vector<shared_ptr<Face>> visited;
+  set.forEach([&visited] (const shared_ptr<Face>& face) { visited.push_back(face); });
+  BOOST_REQUIRE_EQUAL(visited.size(), faces.size() + 1);
+  for (size_t i = 0; i < faces.size(); ++i) {
+    BOOST_CHECK_EQUAL(visited[i], faces[faces.size() - 1 - i]);
+  }
+  BOOST_CHECK_EQUAL(visited.back(), unregistered);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+
+} // namespace tests
+} // namespace fw
+} // namespace nfd
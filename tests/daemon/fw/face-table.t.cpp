@@ -92,6 +92,64 @@ BOOST_AUTO_TEST_CASE(AddReserved)
   BOOST_CHECK_EQUAL(face1->getId(), 5);
 }
 
+BOOST_AUTO_TEST_CASE(GetAfterRemove)
+{
+  Forwarder forwarder;
+  FaceTable& faceTable = forwarder.getFaceTable();
+
+  shared_ptr<Face> face1 = make_shared<DummyFace>();
+  shared_ptr<Face> face2 = make_shared<DummyFace>();
+  faceTable.add(face1);
+  faceTable.add(face2);
+  FaceId id1 = face1->getId();
+  FaceId id2 = face2->getId();
+  BOOST_CHECK_EQUAL(faceTable.get(id1), face1);
+  BOOST_CHECK_EQUAL(faceTable.get(id2), face2);
+  BOOST_CHECK(faceTable.get(INVALID_FACEID) == nullptr);
+  BOOST_CHECK(faceTable.get(id2 + 1000) == nullptr);
+
+  size_t nFaces = faceTable.size();
+  face2->close();
+  face1->close();
+  BOOST_CHECK(faceTable.get(id1) == nullptr);
+  BOOST_CHECK(faceTable.get(id2) == nullptr);
+  BOOST_CHECK_EQUAL(faceTable.size(), nFaces - 2);
+
+  // the slot is reused under a new FaceId, which stale FaceIds do not find
+  shared_ptr<Face> face3 = make_shared<DummyFace>();
+  faceTable.add(face3);
+  FaceId id3 = face3->getId();
+  BOOST_CHECK_EQUAL(id3 & FaceTable::SLOT_MASK, id1 & FaceTable::SLOT_MASK);
+  BOOST_CHECK_NE(id3, id1);
+  BOOST_CHECK_EQUAL(faceTable.get(id3), face3);
+  BOOST_CHECK(faceTable.get(id1) == nullptr);
+  BOOST_CHECK(faceTable.get(id2) == nullptr);
+}
+
+BOOST_AUTO_TEST_CASE(SlotReuse)
+{
+  Forwarder forwarder;
+  FaceTable& faceTable = forwarder.getFaceTable();
+  size_t nFaces = faceTable.size();
+
+  // adding and removing faces repeatedly does not allocate new slots
+  shared_ptr<Face> face1 = make_shared<DummyFace>();
+  faceTable.add(face1);
+  FaceId firstId = face1->getId();
+  std::set<FaceId> ids{firstId};
+  face1->close();
+
+  for (int i = 0; i < 100; ++i) {
+    shared_ptr<Face> face = make_shared<DummyFace>();
+    faceTable.add(face);
+    BOOST_CHECK_EQUAL(face->getId() & FaceTable::SLOT_MASK, firstId & FaceTable::SLOT_MASK);
+    BOOST_CHECK_GT(face->getId(), FACEID_RESERVED_MAX);
+    BOOST_CHECK(ids.insert(face->getId()).second);
+    face->close();
+  }
+  BOOST_CHECK_EQUAL(faceTable.size(), nFaces);
+}
+
 BOOST_AUTO_TEST_CASE(Enumerate)
 {
   Forwarder forwarder;
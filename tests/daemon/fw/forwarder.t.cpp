@@ -24,6 +24,7 @@
  */
 
 #include "fw/forwarder.hpp"
+#include "face/congestion-mark-tag.hpp"
 #include "tests/daemon/face/dummy-face.hpp"
 #include "dummy-strategy.hpp"
 
@@ -424,6 +425,50 @@ BOOST_AUTO_TEST_CASE(IncomingData)
   BOOST_CHECK_EQUAL(face4->m_sentDatas.size(), 1);
 }
 
+BOOST_AUTO_TEST_CASE(IncomingDataCached)
+{
+  Forwarder forwarder;
+  shared_ptr<DummyFace> face1 = make_shared<DummyFace>();
+  shared_ptr<DummyFace> face2 = make_shared<DummyFace>();
+  forwarder.addFace(face1);
+  forwarder.addFace(face2);
+
+  auto findInCs = [&forwarder] (const Name& name) {
+    const Data* found = nullptr;
+    forwarder.getCs().find(*makeInterest(name),
+      [&] (const Interest&, const Data& data) { found = &data; },
+      [] (const Interest&) {});
+    return found;
+  };
+
+  // untagged Data is cached without a copy
+  shared_ptr<Interest> interestA = makeInterest("ndn:/A");
+  shared_ptr<pit::Entry> pitA = forwarder.getPit().insert(*interestA).first;
+  pitA->insertOrUpdateInRecord(face1, *interestA);
+
+  shared_ptr<Data> dataA = makeData("ndn:/A/1");
+  forwarder.onIncomingData(*face2, *dataA);
+  BOOST_CHECK_EQUAL(face1->m_sentDatas.size(), 1);
+  BOOST_CHECK_EQUAL(findInCs("ndn:/A/1"), dataA.get());
+
+  // tagged Data is cached as a copy without tags, and is itself left unmodified
+  shared_ptr<Interest> interestB = makeInterest("ndn:/B");
+  shared_ptr<pit::Entry> pitB = forwarder.getPit().insert(*interestB).first;
+  pitB->insertOrUpdateInRecord(face1, *interestB);
+
+  shared_ptr<Data> dataB = makeData("ndn:/B/1");
+  dataB->setTag(make_shared<CongestionMarkTag>());
+  forwarder.onIncomingData(*face2, *dataB);
+  BOOST_REQUIRE_EQUAL(face1->m_sentDatas.size(), 2);
+  BOOST_CHECK_EQUAL(getCongestionMark(face1->m_sentDatas[1]), 1);
+  BOOST_CHECK_EQUAL(getCongestionMark(*dataB), 1);
+
+  const Data* cachedB = findInCs("ndn:/B/1");
+  BOOST_REQUIRE(cachedB != nullptr);
+  BOOST_CHECK_NE(cachedB, dataB.get());
+  BOOST_CHECK_EQUAL(getCongestionMark(*cachedB), 0);
+}
+
 BOOST_FIXTURE_TEST_CASE(InterestLoopWithShortLifetime, UnitTestTimeFixture) // Bug 1953
 {
   Forwarder forwarder;
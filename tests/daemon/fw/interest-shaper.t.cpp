@@ -0,0 +1,198 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2014-2015,  Regents of the University of California,
+ *                           Arizona Board of Regents,
+ *                           Colorado State University,
+ *                           University Pierre & Marie Curie, Sorbonne University,
+ *                           Washington University in St. Louis,
+ *                           Beijing Institute of Technology,
+ *                           The University of Memphis.
+ *
+ * This file is part of NFD (Named Data Networking Forwarding Daemon).
+ * See AUTHORS.md for complete list of NFD authors and contributors.
+ *
+ * NFD is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * NFD is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * NFD, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+#include "fw/interest-shaper.hpp"
+#include "fw/forwarder.hpp"
+
+#include "tests/test-common.hpp"
+#include "tests/daemon/face/dummy-face.hpp"
+
+namespace nfd {
+namespace fw {
+namespace tests {
+
+using namespace nfd::tests;
+
+class InterestShaperFixture : public UnitTestTimeFixture
+{
+protected:
+  InterestShaperFixture()
+    : face1(make_shared<DummyFace>())
+    , face2(make_shared<DummyFace>())
+  {
+    forwarder.addFace(face1);
+    forwarder.addFace(face2);
+  }
+
+  shared_ptr<pit::Entry>
+  insertPitEntry(const Name& name)
+  {
+    shared_ptr<Interest> interest = makeInterest(name);
+    shared_ptr<pit::Entry> pitEntry = forwarder.getPit().insert(*interest).first;
+    pitEntry->insertOrUpdateInRecord(face1, *interest);
+    return pitEntry;
+  }
+
+protected:
+  Forwarder forwarder;
+  shared_ptr<DummyFace> face1;
+  shared_ptr<DummyFace> face2;
+};
+
+BOOST_FIXTURE_TEST_SUITE(FwInterestShaper, InterestShaperFixture)
+
+BOOST_AUTO_TEST_CASE(Unshaped)
+{
+  InterestShaper shaper;
+  for (int i = 0; i < 100; ++i) {
+    shared_ptr<Interest> interest = makeInterest(Name("/A").appendNumber(i));
+    BOOST_CHECK_EQUAL(shaper.shape(insertPitEntry(interest->getName()), *face2, interest),
+                      InterestShaper::SEND);
+  }
+  BOOST_CHECK_EQUAL(shaper.getDataInterestRatio(face2->getId()), 0);
+}
+
+BOOST_AUTO_TEST_CASE(DelayAndRelease)
+{
+  InterestShaper shaper(time::milliseconds(20), time::milliseconds(100));
+  // 20ms burst holds two Data of initial size
+  shaper.setCapacity(*face2, 1000000);
+
+  std::vector<shared_ptr<Interest>> released;
+  shaper.afterRelease.connect([&] (shared_ptr<pit::Entry>, shared_ptr<Face> face,
+                                   shared_ptr<Interest> interest) {
+    BOOST_CHECK_EQUAL(face, face2);
+    released.push_back(interest);
+  });
+
+  shared_ptr<Interest> interest1 = makeInterest("/A/1");
+  shared_ptr<Interest> interest2 = makeInterest("/A/2");
+  shared_ptr<Interest> interest3 = makeInterest("/A/3");
+  BOOST_CHECK_EQUAL(shaper.shape(insertPitEntry("/A/1"), *face2, interest1), InterestShaper::SEND);
+  BOOST_CHECK_EQUAL(shaper.shape(insertPitEntry("/A/2"), *face2, interest2), InterestShaper::SEND);
+  BOOST_CHECK_EQUAL(shaper.shape(insertPitEntry("/A/3"), *face2, interest3),
+                    InterestShaper::DELAYED);
+  BOOST_CHECK_EQUAL(shaper.getNDelayed(face2->getId()), 1);
+
+  this->advanceClocks(time::milliseconds(1), time::milliseconds(20));
+  BOOST_REQUIRE_EQUAL(released.size(), 1);
+  BOOST_CHECK_EQUAL(released[0], interest3);
+  BOOST_CHECK_EQUAL(shaper.getNDelayed(face2->getId()), 0);
+}
+
+BOOST_AUTO_TEST_CASE(Reject)
+{
+  InterestShaper shaper(time::milliseconds(20), time::milliseconds(100));
+  // a single Data of initial size takes 880ms on this return path
+  shaper.setCapacity(*face2, 10000);
+
+  shared_ptr<Interest> interest1 = makeInterest("/A/1");
+  shared_ptr<Interest> interest2 = makeInterest("/A/2");
+  BOOST_CHECK_EQUAL(shaper.shape(insertPitEntry("/A/1"), *face2, interest1), InterestShaper::SEND);
+  BOOST_CHECK_EQUAL(shaper.shape(insertPitEntry("/A/2"), *face2, interest2),
+                    InterestShaper::REJECTED);
+  BOOST_CHECK_EQUAL(shaper.getNDelayed(face2->getId()), 0);
+
+  // other faces are not affected
+  BOOST_CHECK_EQUAL(shaper.shape(insertPitEntry("/A/2"), *face1, interest2), InterestShaper::SEND);
+}
+
+BOOST_AUTO_TEST_CASE(LearnDataSize)
+{
+  InterestShaper shaper;
+  shaper.setCapacity(*face2, 10000);
+
+  shared_ptr<Interest> interest = makeInterest("/A/1");
+  shaper.shape(insertPitEntry("/A/1"), *face2, interest);
+  double initialRatio = shaper.getDataInterestRatio(face2->getId());
+
+  for (int i = 0; i < 50; ++i) {
+    shaper.afterReceiveData(*face2, *makeData(Name("/A").appendNumber(i)));
+  }
+  BOOST_CHECK_LT(shaper.getDataInterestRatio(face2->getId()), initialRatio / 10);
+
+  // with small Data, many more Interests fit into the same capacity
+  this->advanceClocks(time::seconds(1));
+  int nSent = 0;
+  for (int i = 0; i < 20; ++i) {
+    shared_ptr<Interest> interestB = makeInterest(Name("/B").appendNumber(i));
+    if (shaper.shape(insertPitEntry(interestB->getName()), *face2, interestB) ==
+        InterestShaper::SEND) {
+      ++nSent;
+    }
+  }
+  BOOST_CHECK_GT(nSent, 10);
+}
+
+BOOST_AUTO_TEST_CASE(ForwarderPipeline)
+{
+  forwarder.getInterestShaper().setCapacity(*face2, 1000000);
+
+  shared_ptr<pit::Entry> pitEntry1 = insertPitEntry("/A/1");
+  shared_ptr<pit::Entry> pitEntry2 = insertPitEntry("/A/2");
+  shared_ptr<pit::Entry> pitEntry3 = insertPitEntry("/A/3");
+  forwarder.onOutgoingInterest(pitEntry1, *face2);
+  forwarder.onOutgoingInterest(pitEntry2, *face2);
+  forwarder.onOutgoingInterest(pitEntry3, *face2);
+  BOOST_CHECK_EQUAL(face2->m_sentInterests.size(), 2);
+  // delayed Interest has no OutRecord until it is sent
+  BOOST_CHECK(pitEntry3->getOutRecord(*face2) == pitEntry3->getOutRecords().end());
+  BOOST_CHECK(forwarder.getInterestShaper().hasDelayed(*pitEntry3));
+
+  this->advanceClocks(time::milliseconds(1), time::milliseconds(20));
+  BOOST_CHECK_EQUAL(face2->m_sentInterests.size(), 3);
+  BOOST_CHECK_EQUAL(face2->m_sentInterests.back().getName(), "/A/3");
+  BOOST_CHECK(pitEntry3->getOutRecord(*face2) != pitEntry3->getOutRecords().end());
+  BOOST_CHECK(!forwarder.getInterestShaper().hasDelayed(*pitEntry3));
+}
+
+BOOST_AUTO_TEST_CASE(ExpireWhileDelayed)
+{
+  forwarder.getInterestShaper().setCapacity(*face2, 1000000);
+
+  shared_ptr<pit::Entry> pitEntry1 = insertPitEntry("/A/1");
+  shared_ptr<pit::Entry> pitEntry2 = insertPitEntry("/A/2");
+  shared_ptr<pit::Entry> pitEntry3 = insertPitEntry("/A/3");
+  forwarder.onOutgoingInterest(pitEntry1, *face2);
+  forwarder.onOutgoingInterest(pitEntry2, *face2);
+  forwarder.onOutgoingInterest(pitEntry3, *face2);
+  BOOST_REQUIRE(forwarder.getInterestShaper().hasDelayed(*pitEntry3));
+
+  // the Interest was never transmitted, so it is not a loss on face2
+  forwarder.onInterestUnsatisfied(pitEntry3);
+  BOOST_CHECK_EQUAL(forwarder.getLinkEstimator().get(face2->getId()).getLossPercentage(), 0);
+
+  // the erased PIT entry is not sent when the shaper releases it
+  pitEntry3.reset();
+  this->advanceClocks(time::milliseconds(1), time::milliseconds(20));
+  BOOST_CHECK_EQUAL(face2->m_sentInterests.size(), 2);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+
+} // namespace tests
+} // namespace fw
+} // namespace nfd
@@ -0,0 +1,119 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2015 Klaus Schneider, University of Bamberg, Germany
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ *
+ * Author: Klaus Schneider <klaus.schneider@uni-bamberg.de>
+ */
+
+#include "fw/link-estimator.hpp"
+#include "fw/forwarder.hpp"
+#include "tests/daemon/face/dummy-face.hpp"
+
+#include "tests/test-common.hpp"
+
+namespace nfd {
+namespace fw {
+namespace tests {
+
+using namespace nfd::tests;
+
+BOOST_FIXTURE_TEST_SUITE(FwLinkEstimator, UnitTestTimeFixture)
+
+BOOST_AUTO_TEST_CASE(Window)
+{
+  LinkEstimation le(time::seconds(1));
+  BOOST_CHECK_EQUAL(le.getLossPercentage(), 0.0);
+  BOOST_CHECK_EQUAL(le.getKBytesPerSecond(), 0.0);
+
+  le.addSatisfiedInterest(1024, time::milliseconds(20));
+  le.addLostInterest();
+  BOOST_CHECK_CLOSE(le.getLossPercentage(), 0.5, 0.1);
+  BOOST_CHECK_CLOSE(le.getKBytesPerSecond(), 1.0, 0.1);
+  BOOST_CHECK_CLOSE(le.getCurrentValue(RequirementType::DELAY), 20.0, 0.1);
+
+  this->advanceClocks(time::milliseconds(100), time::milliseconds(600));
+  le.addLostInterest();
+  BOOST_CHECK_CLOSE(le.getLossPercentage(), 2.0 / 3.0, 0.1);
+
+  // first two samples fall out of the window
+  this->advanceClocks(time::milliseconds(100), time::milliseconds(500));
+  BOOST_CHECK_EQUAL(le.getLossPercentage(), 1.0);
+  BOOST_CHECK_EQUAL(le.getKBytesPerSecond(), 0.0);
+  // a face that lost everything is unusable regardless of its RTT
+  BOOST_CHECK_EQUAL(le.getCurrentValue(RequirementType::DELAY), 1000 * 1000);
+}
+
+BOOST_AUTO_TEST_CASE(CongestionMarks)
+{
+  LinkEstimation le(time::seconds(1));
+  BOOST_CHECK_EQUAL(le.getCongestionMarkPercentage(), 0.0);
+
+  le.addSatisfiedInterest(1024, time::milliseconds(20), true);
+  le.addSatisfiedInterest(1024, time::milliseconds(20));
+  le.addLostInterest();
+  // lost Interests bring no Data that could be marked
+  BOOST_CHECK_CLOSE(le.getCurrentValue(RequirementType::CONGESTION), 0.5, 0.1);
+
+  this->advanceClocks(time::milliseconds(100), time::milliseconds(600));
+  le.addSatisfiedInterest(1024, time::milliseconds(20));
+
+  // the marked sample falls out of the window
+  this->advanceClocks(time::milliseconds(100), time::milliseconds(500));
+  BOOST_CHECK_EQUAL(le.getCongestionMarkPercentage(), 0.0);
+}
+
+BOOST_AUTO_TEST_CASE(FedByForwarder)
+{
+  Forwarder forwarder;
+  shared_ptr<DummyFace> face1 = make_shared<DummyFace>();
+  shared_ptr<DummyFace> face2 = make_shared<DummyFace>();
+  forwarder.addFace(face1);
+  forwarder.addFace(face2);
+
+  shared_ptr<fib::Entry> fibEntry = forwarder.getFib().insert(Name("ndn:/A")).first;
+  fibEntry->addNextHop(face2, 0);
+
+  shared_ptr<Interest> interest1 = makeInterest("ndn:/A/1");
+  interest1->setInterestLifetime(time::milliseconds(500));
+  face1->receiveInterest(*interest1);
+  BOOST_REQUIRE_EQUAL(face2->m_sentInterests.size(), 1);
+
+  this->advanceClocks(time::milliseconds(10), 5);
+  shared_ptr<Data> data1 = makeData("ndn:/A/1");
+  face2->receiveData(*data1);
+
+  LinkEstimation& le = forwarder.getLinkEstimator().get(face2->getId());
+  BOOST_CHECK_CLOSE(le.getRttInMilliseconds(), 50.0, 0.1);
+  BOOST_CHECK_EQUAL(le.getLossPercentage(), 0.0);
+
+  shared_ptr<Interest> interest2 = makeInterest("ndn:/A/2");
+  interest2->setInterestLifetime(time::milliseconds(500));
+  face1->receiveInterest(*interest2);
+  BOOST_REQUIRE_EQUAL(face2->m_sentInterests.size(), 2);
+
+  // unsatisfied Interest is counted as loss on the upstream
+  this->advanceClocks(time::milliseconds(100), time::seconds(1));
+  BOOST_CHECK_CLOSE(le.getLossPercentage(), 0.5, 0.1);
+
+  face2->close();
+  BOOST_CHECK_EQUAL(forwarder.getLinkEstimator().size(), 0);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+
+} // namespace tests
+} // namespace fw
+} // namespace nfd
@@ -0,0 +1,89 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2015 Klaus Schneider, University of Bamberg, Germany
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ *
+ * Author: Klaus Schneider <klaus.schneider@uni-bamberg.de>
+ */
+
+#include "fw/rtt-quantile-estimator.hpp"
+#include "fw/strategy-requirements.hpp"
+
+#include "tests/test-common.hpp"
+
+namespace nfd {
+namespace fw {
+namespace tests {
+
+using namespace nfd::tests;
+
+BOOST_FIXTURE_TEST_SUITE(FwRttQuantileEstimator, BaseFixture)
+
+BOOST_AUTO_TEST_CASE(Initial)
+{
+  RttQuantileEstimator rtt(1000, time::milliseconds(10));
+  BOOST_CHECK_EQUAL(rtt.getQuantileInMilliseconds(0.99), 10.0);
+}
+
+BOOST_AUTO_TEST_CASE(HeavyTail)
+{
+  RttQuantileEstimator rtt;
+
+  // 97% of samples at 20ms, 3% at 400ms: good mean, terrible tail
+  for (int i = 0; i < 100; ++i) {
+    for (int j = 0; j < 97; ++j) {
+      rtt.addMeasurement(time::milliseconds(20));
+    }
+    for (int j = 0; j < 3; ++j) {
+      rtt.addMeasurement(time::milliseconds(400));
+    }
+  }
+
+  BOOST_CHECK_CLOSE(rtt.getQuantileInMilliseconds(0.50), 20.0, 5.0);
+  BOOST_CHECK_CLOSE(rtt.getQuantileInMilliseconds(0.95), 20.0, 5.0);
+  BOOST_CHECK_CLOSE(rtt.getQuantileInMilliseconds(0.99), 400.0, 5.0);
+}
+
+BOOST_AUTO_TEST_CASE(Aging)
+{
+  RttQuantileEstimator rtt(100);
+
+  for (int i = 0; i < 100; ++i) {
+    rtt.addMeasurement(time::milliseconds(300));
+  }
+  BOOST_CHECK_CLOSE(rtt.getQuantileInMilliseconds(0.5), 300.0, 5.0);
+
+  // old samples lose weight as new ones arrive
+  for (int i = 0; i < 1000; ++i) {
+    rtt.addMeasurement(time::milliseconds(5));
+  }
+  BOOST_CHECK_CLOSE(rtt.getQuantileInMilliseconds(0.95), 5.0, 5.0);
+}
+
+BOOST_AUTO_TEST_CASE(ParsePercentileRequirements)
+{
+  StrategyRequirements req;
+  BOOST_CHECK(req.parseParameters("delay-p99%3D150%2Cmaxloss%3D0.1"));
+  BOOST_CHECK(req.contains(RequirementType::DELAY_P99));
+  BOOST_CHECK(!req.contains(RequirementType::DELAY));
+  BOOST_CHECK_EQUAL(req.getLimit(RequirementType::DELAY_P99), 150);
+  BOOST_CHECK(req.getDelayType() == RequirementType::DELAY_P99);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+
+} // namespace tests
+} // namespace fw
+} // namespace nfd
@@ -0,0 +1,216 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2014-2015,  Regents of the University of California,
+ *                           Arizona Board of Regents,
+ *                           Colorado State University,
+ *                           University Pierre & Marie Curie, Sorbonne University,
+ *                           Washington University in St. Louis,
+ *                           Beijing Institute of Technology,
+ *                           The University of Memphis.
+ *
+ * This file is part of NFD (Named Data Networking Forwarding Daemon).
+ * See AUTHORS.md for complete list of NFD authors and contributors.
+ *
+ * NFD is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * NFD is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * NFD, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+#include "fw/traffic-manager.hpp"
+#include "face/congestion-mark-tag.hpp"
+
+#include "tests/test-common.hpp"
+#include "tests/daemon/face/dummy-face.hpp"
+
+namespace nfd {
+namespace fw {
+namespace tests {
+
+using namespace nfd::tests;
+
+/** \brief a DummyFace whose send buffer drains only when told to
+ */
+class BacklogFace : public DummyFace
+{
+public:
+  BacklogFace()
+    : m_backlog(0)
+  {
+  }
+
+  void
+  sendData(const Data& data) DECL_OVERRIDE
+  {
+    DummyFace::sendData(data);
+    m_backlog += data.wireEncode().size();
+  }
+
+  size_t
+  getSendQueueLength() const DECL_OVERRIDE
+  {
+    return m_backlog;
+  }
+
+  void
+  drain()
+  {
+    m_backlog = 0;
+    this->emitSignal(onTransmitComplete);
+  }
+
+public:
+  size_t m_backlog;
+};
+
+static shared_ptr<Data>
+makeDataWithPayload(const Name& name, size_t payloadSize)
+{
+  shared_ptr<Data> data = make_shared<Data>(name);
+  std::vector<uint8_t> payload(payloadSize);
+  data->setContent(payload.data(), payload.size());
+  return signData(data);
+}
+
+BOOST_FIXTURE_TEST_SUITE(FwTrafficManager, UnitTestTimeFixture)
+
+BOOST_AUTO_TEST_CASE(PassThrough)
+{
+  TrafficManager tm(100000, 1);
+  shared_ptr<DummyFace> face = make_shared<DummyFace>();
+
+  for (int i = 0; i < 10; ++i) {
+    tm.sendData(*face, *makeData(Name("/A").appendNumber(i)));
+  }
+  BOOST_CHECK_EQUAL(face->m_sentDatas.size(), 10);
+  BOOST_CHECK_EQUAL(tm.getQueueSize(face->getId()), 0);
+  BOOST_CHECK_EQUAL(face->getCounters().getNQueuedDatas(), 0);
+}
+
+BOOST_AUTO_TEST_CASE(QueueWhileBacklogged)
+{
+  TrafficManager tm(100000, 1);
+  shared_ptr<BacklogFace> face = make_shared<BacklogFace>();
+
+  tm.sendData(*face, *makeData("/A/0"));
+  tm.sendData(*face, *makeData("/A/1"));
+  tm.sendData(*face, *makeData("/A/2"));
+  BOOST_CHECK_EQUAL(face->m_sentDatas.size(), 1);
+  BOOST_CHECK_EQUAL(tm.getQueueSize(face->getId()), 2);
+
+  this->advanceClocks(time::milliseconds(2));
+  face->drain();
+  BOOST_CHECK_EQUAL(face->m_sentDatas.size(), 2);
+  BOOST_CHECK_EQUAL(face->m_sentDatas.back().getName(), "/A/1");
+
+  face->drain();
+  BOOST_CHECK_EQUAL(face->m_sentDatas.size(), 3);
+  BOOST_CHECK_EQUAL(tm.getQueueSize(face->getId()), 0);
+
+  BOOST_CHECK_EQUAL(face->getCounters().getNQueuedDatas(), 2);
+  BOOST_CHECK(time::nanoseconds(face->getCounters().getQueueDelay()) >= time::milliseconds(4));
+  BOOST_CHECK_EQUAL(face->getCounters().getNOutDataDrops(), 0);
+}
+
+BOOST_AUTO_TEST_CASE(TailDrop)
+{
+  shared_ptr<Data> data0 = makeDataWithPayload("/A/0", 1000);
+  shared_ptr<Data> data1 = makeDataWithPayload("/A/1", 1000);
+  shared_ptr<Data> data2 = makeDataWithPayload("/A/2", 1000);
+  shared_ptr<Data> data3 = makeDataWithPayload("/A/3", 1000);
+
+  TrafficManager tm(data1->wireEncode().size() + data2->wireEncode().size(), 1);
+  shared_ptr<BacklogFace> face = make_shared<BacklogFace>();
+
+  tm.sendData(*face, *data0);
+  tm.sendData(*face, *data1);
+  tm.sendData(*face, *data2);
+  tm.sendData(*face, *data3);
+  BOOST_CHECK_EQUAL(face->m_sentDatas.size(), 1);
+  BOOST_CHECK_EQUAL(tm.getQueueSize(face->getId()), 2);
+  BOOST_CHECK_EQUAL(face->getCounters().getNOutDataDrops(), 1);
+}
+
+BOOST_AUTO_TEST_CASE(CodelDrop)
+{
+  const size_t N_DATA = 50;
+
+  TrafficManager tm(1000000, 1);
+  shared_ptr<BacklogFace> face = make_shared<BacklogFace>();
+
+  // one Data goes to the face, the rest builds a standing queue
+  for (size_t i = 0; i < N_DATA; ++i) {
+    tm.sendData(*face, *makeDataWithPayload(Name("/A").appendNumber(i), 1000));
+  }
+  BOOST_CHECK_EQUAL(tm.getQueueSize(face->getId()), N_DATA - 1);
+
+  // the face sends one Data per 5ms, so the sojourn time stays far above target
+  while (tm.getQueueSize(face->getId()) > 0) {
+    this->advanceClocks(time::milliseconds(5));
+    face->drain();
+  }
+
+  const FaceCounters& counters = face->getCounters();
+  BOOST_CHECK_GT(counters.getNOutDataDrops(), 0);
+  BOOST_CHECK_EQUAL(face->m_sentDatas.size() + counters.getNOutDataDrops(), N_DATA);
+  BOOST_CHECK_EQUAL(counters.getNQueuedDatas(), face->m_sentDatas.size() - 1);
+}
+
+BOOST_AUTO_TEST_CASE(CongestionMark)
+{
+  TrafficManager tm(100000, 1);
+  shared_ptr<BacklogFace> face = make_shared<BacklogFace>();
+
+  shared_ptr<Data> data1 = makeData("/A/1");
+  shared_ptr<Data> data2 = makeData("/A/2");
+  tm.sendData(*face, *makeData("/A/0"));
+  tm.sendData(*face, *data1);
+  tm.sendData(*face, *data2);
+
+  // data1 waits less than the target delay
+  this->advanceClocks(time::milliseconds(1));
+  face->drain();
+  // data2 waits longer than the target delay
+  this->advanceClocks(time::milliseconds(10));
+  face->drain();
+
+  BOOST_REQUIRE_EQUAL(face->m_sentDatas.size(), 3);
+  BOOST_CHECK_EQUAL(getCongestionMark(face->m_sentDatas[0]), 0);
+  BOOST_CHECK_EQUAL(getCongestionMark(face->m_sentDatas[1]), 0);
+  BOOST_CHECK_EQUAL(getCongestionMark(face->m_sentDatas[2]), 1);
+  BOOST_CHECK_EQUAL(face->getCounters().getNOutCongestionMarks(), 1);
+
+  // the queued Data may be shared with other downstreams, and must stay unmarked
+  BOOST_CHECK_EQUAL(getCongestionMark(*data2), 0);
+}
+
+BOOST_AUTO_TEST_CASE(CodelNoDropBelowTarget)
+{
+  TrafficManager tm(1000000, 1);
+  shared_ptr<BacklogFace> face = make_shared<BacklogFace>();
+
+  // a short burst that drains within the target delay is never dropped
+  for (size_t i = 0; i < 500; ++i) {
+    tm.sendData(*face, *makeDataWithPayload(Name("/A").appendNumber(i), 1000));
+    tm.sendData(*face, *makeDataWithPayload(Name("/B").appendNumber(i), 1000));
+    this->advanceClocks(time::milliseconds(1));
+    face->drain();
+    face->drain();
+  }
+
+  BOOST_CHECK_EQUAL(face->getCounters().getNOutDataDrops(), 0);
+  BOOST_CHECK_EQUAL(face->m_sentDatas.size(), 1000);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+
+} // namespace tests
+} // namespace fw
+} // namespace nfd
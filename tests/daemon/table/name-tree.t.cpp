@@ -48,6 +48,20 @@ BOOST_AUTO_TEST_CASE(Hash)
   BOOST_CHECK_EQUAL(hashSet.size(), prefix.size() + 1);
 }
 
+BOOST_AUTO_TEST_CASE(Prefetch)
+{
+  NameTree nt(16);
+  nt.lookup("/a/b/c");
+
+  // prefetching is a hint only, and works on present and absent names alike
+  for (const Name& name : {Name("/a/b/c/d"), Name("/x/y"), Name("/")}) {
+    std::vector<size_t> hashSet = nt.prefetchBuckets(name);
+    BOOST_CHECK(hashSet == name_tree::computeHashSet(name));
+    nt.prefetchNodes(hashSet);
+  }
+  BOOST_CHECK_EQUAL(nt.size(), 4);
+}
+
 BOOST_AUTO_TEST_CASE(Entry)
 {
   Name prefix("ndn:/named-data/research/abc/def/ghi");
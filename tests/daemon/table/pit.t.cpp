@@ -394,6 +394,42 @@ BOOST_AUTO_TEST_CASE(EraseNameTreeEntry)
   BOOST_CHECK_EQUAL(nameTree.size(), nNameTreeEntriesBefore);
 }
 
+BOOST_AUTO_TEST_CASE(DeleteFaceRecords)
+{
+  NameTree nameTree(16);
+  Pit pit(nameTree);
+  shared_ptr<Face> face1 = make_shared<DummyFace>();
+  shared_ptr<Face> face2 = make_shared<DummyFace>();
+
+  shared_ptr<Interest> interestA = makeInterest("/A");
+  shared_ptr<pit::Entry> entryA = pit.insert(*interestA).first;
+  entryA->insertOrUpdateInRecord(face1, *interestA);
+  entryA->insertOrUpdateOutRecord(face2, *interestA);
+
+  shared_ptr<Interest> interestB = makeInterest("/B");
+  shared_ptr<pit::Entry> entryB = pit.insert(*interestB).first;
+  entryB->insertOrUpdateInRecord(face2, *interestB);
+  entryB->insertOrUpdateOutRecord(face1, *interestB);
+  entryB->deleteOutRecord(*face1);
+
+  shared_ptr<Interest> interestC = makeInterest("/C");
+  shared_ptr<pit::Entry> entryC = pit.insert(*interestC).first;
+  entryC->insertOrUpdateInRecord(face1, *interestC);
+  pit.erase(entryC);
+
+  // only entryA still refers to face1
+  pit.deleteFaceRecords(*face1);
+  BOOST_CHECK(entryA->getInRecords().empty());
+  BOOST_CHECK_EQUAL(entryA->getOutRecords().size(), 1);
+  BOOST_CHECK_EQUAL(entryB->getInRecords().size(), 1);
+  BOOST_CHECK_EQUAL(entryC->getInRecords().size(), 1);
+  BOOST_CHECK_EQUAL(pit.size(), 2);
+
+  pit.deleteFaceRecords(*face2);
+  BOOST_CHECK(entryA->getOutRecords().empty());
+  BOOST_CHECK(entryB->getInRecords().empty());
+}
+
 BOOST_AUTO_TEST_CASE(FindAllDataMatches)
 {
   Name nameA   ("ndn:/A");
@@ -238,6 +238,37 @@ BOOST_AUTO_TEST_CASE(EraseNameTreeEntry)
   BOOST_CHECK_EQUAL(nameTree.size(), nNameTreeEntriesBefore);
 }
 
+BOOST_AUTO_TEST_CASE(EffectiveCachedOnNameTree)
+{
+  Forwarder forwarder;
+  Name nameP("ndn:/strategy/P/%FD%01");
+  Name nameQ("ndn:/strategy/Q/%FD%01");
+  shared_ptr<Strategy> strategyP = make_shared<DummyStrategy>(ref(forwarder), nameP);
+  shared_ptr<Strategy> strategyQ = make_shared<DummyStrategy>(ref(forwarder), nameQ);
+
+  StrategyChoice& table = forwarder.getStrategyChoice();
+  table.install(strategyP);
+  table.install(strategyQ);
+  BOOST_CHECK(table.insert("ndn:/", nameP));
+
+  shared_ptr<pit::Entry> pitEntry = forwarder.getPit().insert(*makeInterest("ndn:/A/B")).first;
+  BOOST_CHECK_EQUAL(&table.findEffectiveStrategy(*pitEntry), strategyP.get());
+  // served from the cache on the NameTree entry
+  BOOST_CHECK_EQUAL(&table.findEffectiveStrategy(*pitEntry), strategyP.get());
+
+  // insert invalidates cached results
+  BOOST_CHECK(table.insert("ndn:/A", Name(nameQ).append("maxdelay=100")));
+  BOOST_CHECK_EQUAL(&table.findEffectiveStrategy(*pitEntry), strategyQ.get());
+  const fw::StrategyParameters& params = table.findEffectiveParameters(*pitEntry);
+  BOOST_CHECK(params.has("maxdelay"));
+  BOOST_CHECK_EQUAL(params.getRequirements().getLimit(fw::RequirementType::DELAY), 100);
+
+  // erase invalidates cached results
+  table.erase("ndn:/A");
+  BOOST_CHECK_EQUAL(&table.findEffectiveStrategy(*pitEntry), strategyP.get());
+  BOOST_CHECK(!table.findEffectiveParameters(*pitEntry).has("maxdelay"));
+}
+
 BOOST_AUTO_TEST_CASE(Versioning)
 {
   Forwarder forwarder;
@@ -0,0 +1,114 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2014-2015,  Regents of the University of California,
+ *                           Arizona Board of Regents,
+ *                           Colorado State University,
+ *                           University Pierre & Marie Curie, Sorbonne University,
+ *                           Washington University in St. Louis,
+ *                           Beijing Institute of Technology,
+ *                           The University of Memphis.
+ *
+ * This file is part of NFD (Named Data Networking Forwarding Daemon).
+ * See AUTHORS.md for complete list of NFD authors and contributors.
+ *
+ * NFD is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * NFD is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * NFD, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/** \file
+ *  \brief cost of giving a forwarded Interest a new Nonce
+ *
+ *  Compares Forwarder::makeInterestWithNonce, which patches the Nonce in a copy of the
+ *  wire encoding and decodes it, with copying the Interest and calling setNonce.
+ *  Each case includes wireEncode, because a face encodes the Interest when it is sent.
+ */
+
+#include "fw/forwarder.hpp"
+
+#include "tests/test-common.hpp"
+
+namespace nfd {
+namespace tests {
+
+class InterestNonceBenchmarkFixture : public BaseFixture
+{
+protected:
+  InterestNonceBenchmarkFixture()
+  {
+#ifdef _DEBUG
+    BOOST_TEST_MESSAGE("Benchmark compiled in debug mode is unreliable, "
+                       "please compile in release mode.");
+#endif // _DEBUG
+
+    // Interests as they are received: decoded from a wire encoding
+    for (size_t i = 0; i < N_WORKLOAD; ++i) {
+      Name name("/interest/nonce/benchmark");
+      name.appendNumber(i % 16).appendSegment(i);
+      shared_ptr<Interest> interest = makeInterest(name);
+      interest->setMustBeFresh(true);
+      interest->setInterestLifetime(time::seconds(2));
+      interest->setNonce(static_cast<uint32_t>(i));
+      workload.push_back(make_shared<Interest>(interest->wireEncode()));
+    }
+  }
+
+  time::microseconds
+  timedRun(std::function<void()> f)
+  {
+    time::steady_clock::TimePoint t1 = time::steady_clock::now();
+    f();
+    time::steady_clock::TimePoint t2 = time::steady_clock::now();
+    return time::duration_cast<time::microseconds>(t2 - t1);
+  }
+
+protected:
+  static const size_t N_WORKLOAD = 100000;
+  static const size_t REPEAT = 4;
+  std::vector<shared_ptr<Interest>> workload;
+};
+
+BOOST_FIXTURE_TEST_SUITE(FwInterestNonceBenchmark, InterestNonceBenchmarkFixture)
+
+BOOST_AUTO_TEST_CASE(PatchWire)
+{
+  size_t totalSize = 0;
+  time::microseconds d = timedRun([&] {
+    for (size_t j = 0; j < REPEAT; ++j) {
+      for (size_t i = 0; i < N_WORKLOAD; ++i) {
+        shared_ptr<Interest> copy = Forwarder::makeInterestWithNonce(*workload[i], i + j);
+        totalSize += copy->wireEncode().size();
+      }
+    }
+  });
+  BOOST_TEST_MESSAGE("makeInterestWithNonce+wireEncode " << (N_WORKLOAD * REPEAT) << ": " << d);
+  BOOST_CHECK_GT(totalSize, 0);
+}
+
+BOOST_AUTO_TEST_CASE(CopyAndSetNonce)
+{
+  size_t totalSize = 0;
+  time::microseconds d = timedRun([&] {
+    for (size_t j = 0; j < REPEAT; ++j) {
+      for (size_t i = 0; i < N_WORKLOAD; ++i) {
+        shared_ptr<Interest> copy = make_shared<Interest>(*workload[i]);
+        copy->setNonce(i + j);
+        totalSize += copy->wireEncode().size();
+      }
+    }
+  });
+  BOOST_TEST_MESSAGE("copy+setNonce+wireEncode " << (N_WORKLOAD * REPEAT) << ": " << d);
+  BOOST_CHECK_GT(totalSize, 0);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+
+} // namespace tests
+} // namespace nfd
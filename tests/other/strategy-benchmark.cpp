@@ -0,0 +1,457 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2014-2015,  Regents of the University of California,
+ *                           Arizona Board of Regents,
+ *                           Colorado State University,
+ *                           University Pierre & Marie Curie, Sorbonne University,
+ *                           Washington University in St. Louis,
+ *                           Beijing Institute of Technology,
+ *                           The University of Memphis.
+ *
+ * This file is part of NFD (Named Data Networking Forwarding Daemon).
+ * See AUTHORS.md for complete list of NFD authors and contributors.
+ *
+ * NFD is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * NFD is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * NFD, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/** \file
+ *  \brief offline evaluation of forwarding strategies
+ *
+ *  A single Forwarder is connected to one consumer face and several synthetic upstream faces.
+ *  Each upstream face models delay, jitter, loss, and bandwidth in virtual time, so that
+ *  a run of several virtual seconds completes in a fraction of a real second.
+ *  Returning Data and the forwarder's timers are events of the ns-3 simulator, which is
+ *  run in lockstep with the unit test clock.
+ *
+ *  For each strategy, the benchmark reports
+ *  - decision cost: wall-clock time and heap allocations per consumer Interest spent in
+ *    the incoming Interest pipeline (including the strategy's afterReceiveInterest)
+ *  - outcome: throughput, delay percentiles, loss, and probe overhead
+ *    (upstream Interests per consumer Interest)
+ */
+
+#include "fw/forwarder.hpp"
+#include "fw/access-strategy.hpp"
+#include "fw/best-route-strategy2.hpp"
+#include "fw/lowest-cost-strategy.hpp"
+#include "fw/madm-strategy.hpp"
+#include "fw/ncc-strategy.hpp"
+
+#include "tests/test-common.hpp"
+
+#include "ns3/simulator.h"
+
+#include <boost/random/mersenne_twister.hpp>
+#include <boost/random/normal_distribution.hpp>
+#include <boost/random/uniform_real_distribution.hpp>
+
+#include <chrono>
+#include <cstdlib>
+#include <new>
+
+namespace nfd {
+namespace tests {
+
+/** \brief number of heap allocations made by this program
+ */
+static size_t g_nAllocations = 0;
+
+} // namespace tests
+} // namespace nfd
+
+void*
+operator new(std::size_t size)
+{
+  ++nfd::tests::g_nAllocations;
+  void* p = std::malloc(size == 0 ? 1 : size);
+  if (p == nullptr) {
+    throw std::bad_alloc();
+  }
+  return p;
+}
+
+void
+operator delete(void* p) noexcept
+{
+  std::free(p);
+}
+
+namespace nfd {
+namespace tests {
+
+/** \brief properties of a synthetic link
+ */
+struct LinkModel
+{
+  std::string name;
+  time::nanoseconds delay;
+  time::nanoseconds jitter; ///< standard deviation of the one-way delay
+  double loss; ///< probability that an Interest or its Data is lost
+  double bandwidth; ///< bytes per second in the Data direction
+  uint64_t cost; ///< routing cost of the FIB nexthop
+};
+
+/** \brief a face whose sent packets are handed to the benchmark instead of a socket
+ */
+class BenchmarkFace : public Face
+{
+public:
+  BenchmarkFace()
+    : Face(FaceUri("dummy://"), FaceUri("dummy://"))
+  {
+  }
+
+  void
+  sendInterest(const Interest& interest) DECL_OVERRIDE
+  {
+    ++m_nSentInterests;
+    m_pendingInterests.push_back(interest);
+  }
+
+  void
+  sendData(const Data& data) DECL_OVERRIDE
+  {
+    ++m_nSentDatas;
+    m_pendingDatas.push_back(data);
+  }
+
+  void
+  close() DECL_OVERRIDE
+  {
+    this->fail("close");
+  }
+
+  void
+  receiveInterest(const Interest& interest)
+  {
+    this->emitSignal(onReceiveInterest, interest);
+  }
+
+  void
+  receiveData(const Data& data)
+  {
+    this->emitSignal(onReceiveData, data);
+  }
+
+public:
+  size_t m_nSentInterests = 0;
+  size_t m_nSentDatas = 0;
+  std::vector<Interest> m_pendingInterests;
+  std::vector<Data> m_pendingDatas;
+};
+
+/** \brief outcome of one run
+ */
+struct BenchmarkResult
+{
+  size_t nInterests = 0;
+  size_t nSatisfied = 0;
+  size_t nUpstreamInterests = 0;
+  std::chrono::nanoseconds decisionTime = std::chrono::nanoseconds::zero();
+  size_t nAllocations = 0;
+  std::vector<double> delays; ///< consumer-observed delays in milliseconds
+  time::nanoseconds duration;
+
+  double
+  getDelayPercentile(double q) const
+  {
+    if (delays.empty()) {
+      return 0;
+    }
+    size_t index = static_cast<size_t>(q * (delays.size() - 1));
+    return delays[index];
+  }
+};
+
+std::ostream&
+operator<<(std::ostream& os, const BenchmarkResult& r)
+{
+  double seconds = time::duration_cast<time::microseconds>(r.duration).count() / 1000000.0;
+  os << "decision " << (r.decisionTime.count() / r.nInterests) << "ns/Interest "
+     << (static_cast<double>(r.nAllocations) / r.nInterests) << "alloc/Interest, "
+     << "throughput " << (r.nSatisfied / seconds) << "Data/s, "
+     << "delay p50=" << r.getDelayPercentile(0.50) << "ms "
+     << "p95=" << r.getDelayPercentile(0.95) << "ms "
+     << "p99=" << r.getDelayPercentile(0.99) << "ms, "
+     << "loss " << (1.0 - static_cast<double>(r.nSatisfied) / r.nInterests) << ", "
+     << "probe overhead " << (static_cast<double>(r.nUpstreamInterests) / r.nInterests);
+  return os;
+}
+
+/** \brief discards the events left in the ns-3 simulator by an earlier run
+ *
+ *  This is a base class, so that it is constructed before the Forwarder schedules
+ *  its first event.
+ */
+class SimulatorResetFixture
+{
+protected:
+  SimulatorResetFixture()
+  {
+    ns3::Simulator::Destroy();
+  }
+};
+
+class StrategyBenchmarkFixture : public UnitTestTimeFixture, protected SimulatorResetFixture
+{
+protected:
+  StrategyBenchmarkFixture()
+    : consumer(make_shared<BenchmarkFace>())
+    , m_rng(13)
+  {
+#ifdef _DEBUG
+    BOOST_TEST_MESSAGE("Benchmark compiled in debug mode is unreliable, "
+                       "please compile in release mode.");
+#endif // _DEBUG
+
+    forwarder.addFace(consumer);
+  }
+
+  /** \brief create an upstream face with the given link model
+   */
+  void
+  addLink(const LinkModel& model)
+  {
+    Link link;
+    link.model = model;
+    link.face = make_shared<BenchmarkFace>();
+    link.busyUntil = time::steady_clock::TimePoint::min();
+    forwarder.addFace(link.face);
+    forwarder.getFib().insert(PREFIX).first->addNextHop(link.face, model.cost);
+    m_links.push_back(link);
+  }
+
+  /** \brief choose strategy S, optionally with parameters, for PREFIX
+   */
+  template<typename S>
+  void
+  setStrategy(const std::string& parameters = "")
+  {
+    StrategyChoice& strategyChoice = forwarder.getStrategyChoice();
+    shared_ptr<S> strategy = make_shared<S>(ref(forwarder));
+    strategyChoice.install(strategy);
+
+    Name strategyName = strategy->getName();
+    if (!parameters.empty()) {
+      strategyName.append(parameters);
+    }
+    strategyChoice.insert(PREFIX, strategyName);
+  }
+
+  /** \brief replay a consumer workload of constant rate
+   *  \param rate Interests per second
+   *  \param duration length of the workload; the run continues for one lifetime afterwards
+   */
+  BenchmarkResult
+  run(size_t rate, const time::nanoseconds& duration)
+  {
+    BenchmarkResult result;
+    result.duration = duration;
+
+    time::nanoseconds interval = time::nanoseconds(time::seconds(1)) / rate;
+    size_t nInterests = static_cast<size_t>(duration / interval);
+    m_sendTimes.assign(nInterests, time::steady_clock::TimePoint::min());
+
+    for (size_t seq = 0; seq < nInterests; ++seq) {
+      shared_ptr<Interest> interest = makeInterest(Name(PREFIX).appendSequenceNumber(seq));
+      interest->setInterestLifetime(LIFETIME);
+      interest->setNonce(static_cast<uint32_t>(seq));
+      interest->wireEncode();
+      m_sendTimes[seq] = time::steady_clock::now();
+
+      size_t nAllocationsBefore = g_nAllocations;
+      std::chrono::steady_clock::time_point t1 = std::chrono::steady_clock::now();
+      consumer->receiveInterest(*interest);
+      std::chrono::steady_clock::time_point t2 = std::chrono::steady_clock::now();
+      result.nAllocations += g_nAllocations - nAllocationsBefore;
+      result.decisionTime += std::chrono::duration_cast<std::chrono::nanoseconds>(t2 - t1);
+      ++result.nInterests;
+
+      this->step(interval, result);
+    }
+
+    this->step(time::nanoseconds(LIFETIME), result);
+
+    for (const Link& link : m_links) {
+      result.nUpstreamInterests += link.face->m_nSentInterests;
+    }
+    std::sort(result.delays.begin(), result.delays.end());
+    return result;
+  }
+
+private:
+  struct Link
+  {
+    LinkModel model;
+    shared_ptr<BenchmarkFace> face;
+    time::steady_clock::TimePoint busyUntil;
+  };
+
+  /** \brief advance the clock, delivering packets sent by the forwarder along the way
+   *
+   *  Each tick advances the unit test clocks, read through time::steady_clock, and then runs
+   *  the ns-3 events that fall into the tick, where scheduler::schedule places them.
+   *  UnitTestTimeFixture::advanceClocks is not used, because it polls the global io_service,
+   *  which is a placeholder in ndnSIM.
+   */
+  void
+  step(const time::nanoseconds& total, BenchmarkResult& result)
+  {
+    time::nanoseconds remaining = total;
+    while (remaining > time::nanoseconds::zero()) {
+      this->deliver(result);
+      time::nanoseconds tick = std::min(remaining, time::nanoseconds(TICK));
+      steadyClock->advance(tick);
+      systemClock->advance(tick);
+      ns3::Simulator::Stop(ns3::NanoSeconds(tick.count()));
+      ns3::Simulator::Run();
+      remaining -= tick;
+    }
+    this->deliver(result);
+  }
+
+  void
+  deliver(BenchmarkResult& result)
+  {
+    for (Link& link : m_links) {
+      for (const Interest& interest : link.face->m_pendingInterests) {
+        this->transmit(link, interest);
+      }
+      link.face->m_pendingInterests.clear();
+      link.face->m_pendingDatas.clear();
+    }
+
+    for (const Data& data : consumer->m_pendingDatas) {
+      uint64_t seq = data.getName().get(-1).toSequenceNumber();
+      if (seq < m_sendTimes.size() && m_sendTimes[seq] != time::steady_clock::TimePoint::min()) {
+        time::nanoseconds delay = time::steady_clock::now() - m_sendTimes[seq];
+        result.delays.push_back(time::duration_cast<time::microseconds>(delay).count() / 1000.0);
+        m_sendTimes[seq] = time::steady_clock::TimePoint::min();
+        ++result.nSatisfied;
+      }
+    }
+    consumer->m_pendingDatas.clear();
+  }
+
+  /** \brief send interest over the link, and schedule the returning Data
+   */
+  void
+  transmit(Link& link, const Interest& interest)
+  {
+    if (m_uniform(m_rng) < link.model.loss) {
+      return;
+    }
+
+    shared_ptr<Data> data = make_shared<Data>(interest.getName());
+    data->setContent(m_payload, sizeof(m_payload));
+    signData(data);
+
+    // Data is serialized onto the link after all Data already queued
+    time::steady_clock::TimePoint now = time::steady_clock::now();
+    time::nanoseconds txTime(static_cast<time::nanoseconds::rep>(
+      data->wireEncode().size() / link.model.bandwidth * 1000000000.0));
+    link.busyUntil = std::max(link.busyUntil, now) + txTime;
+
+    double jitter = m_normal(m_rng) * link.model.jitter.count();
+    time::nanoseconds rtt = (link.busyUntil - now) + 2 * link.model.delay +
+                            time::nanoseconds(static_cast<time::nanoseconds::rep>(jitter));
+    rtt = std::max(rtt, time::nanoseconds::zero());
+
+    shared_ptr<BenchmarkFace> face = link.face;
+    scheduler::schedule(rtt, [face, data] { face->receiveData(*data); });
+  }
+
+protected:
+  static const Name PREFIX;
+  static const time::milliseconds LIFETIME;
+  static const time::milliseconds TICK;
+
+  Forwarder forwarder;
+  shared_ptr<BenchmarkFace> consumer;
+
+private:
+  std::vector<Link> m_links;
+  std::vector<time::steady_clock::TimePoint> m_sendTimes;
+  uint8_t m_payload[1024] = {};
+
+  boost::random::mt19937 m_rng;
+  boost::random::uniform_real_distribution<double> m_uniform;
+  boost::random::normal_distribution<double> m_normal;
+};
+
+const Name StrategyBenchmarkFixture::PREFIX("ndn:/benchmark");
+const time::milliseconds StrategyBenchmarkFixture::LIFETIME(1000);
+const time::milliseconds StrategyBenchmarkFixture::TICK(1);
+
+/** \brief three upstreams: fast but lossy, medium, slow but reliable
+ */
+class ThreeLinksFixture : public StrategyBenchmarkFixture
+{
+protected:
+  ThreeLinksFixture()
+  {
+    addLink({"fast-lossy", time::milliseconds(10), time::milliseconds(2), 0.10, 1000000, 1});
+    addLink({"medium", time::milliseconds(30), time::milliseconds(5), 0.005, 500000, 2});
+    addLink({"slow-reliable", time::milliseconds(80), time::milliseconds(10), 0.0, 2000000, 3});
+  }
+
+  void
+  report(const std::string& strategy, const BenchmarkResult& result)
+  {
+    BOOST_TEST_MESSAGE(strategy << ": " << result);
+    // every link returns most Data, so a run without any is not measuring the strategy
+    BOOST_CHECK_GT(result.nSatisfied, 0);
+  }
+
+protected:
+  static const size_t RATE = 500;
+  static const time::seconds DURATION;
+};
+
+const time::seconds ThreeLinksFixture::DURATION(10);
+
+BOOST_FIXTURE_TEST_SUITE(FwStrategyBenchmark, ThreeLinksFixture)
+
+BOOST_AUTO_TEST_CASE(BestRoute)
+{
+  setStrategy<fw::BestRouteStrategy2>();
+  report("best-route", run(RATE, DURATION));
+}
+
+BOOST_AUTO_TEST_CASE(Ncc)
+{
+  setStrategy<fw::NccStrategy>();
+  report("ncc", run(RATE, DURATION));
+}
+
+BOOST_AUTO_TEST_CASE(Access)
+{
+  setStrategy<fw::AccessStrategy>();
+  report("access", run(RATE, DURATION));
+}
+
+BOOST_AUTO_TEST_CASE(LowestCost)
+{
+  setStrategy<fw::LowestCostStrategy>("maxdelay=100,maxloss=0.05");
+  report("lowest-cost", run(RATE, DURATION));
+}
+
+BOOST_AUTO_TEST_CASE(Madm)
+{
+  setStrategy<fw::MadmStrategy>("maxdelay=100,maxloss=0.05");
+  report("madm", run(RATE, DURATION));
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+
+} // namespace tests
+} // namespace nfd